@@ -0,0 +1,84 @@
+// Measures what delivering an event to Electron costs on the JS thread.
+//
+// Fires PttOpen/PttClosed (ordered, a boolean argument) and StationTransceiversUpdated (coalesced,
+// a string and a number) through the event injector and times the batches reaching the callback.
+// Needs an addon built with TRACKAUDIO_FAKE_AFV: `node scripts/build-napi.js --fake-afv`.
+//
+// Usage: node bench/electron-events.bench.mjs [events=200000]
+import { mkdtempSync, rmSync, writeFileSync } from 'fs';
+import { createRequire } from 'module';
+import { tmpdir } from 'os';
+import path from 'path';
+
+const require = createRequire(import.meta.url);
+const { TrackAudioAfv } = require('../js/bindings.js');
+
+const eventCount = Number(process.argv[2] ?? 200000);
+const timeoutMs = 60000;
+
+if (!TrackAudioAfv.RunAfvEventScript) {
+    console.error('The addon was built without TRACKAUDIO_FAKE_AFV, nothing to measure');
+    process.exit(1);
+}
+
+const workDir = mkdtempSync(path.join(tmpdir(), 'trackaudio-bench-'));
+const scriptPath = path.join(workDir, 'events.txt');
+const lines = [];
+for (let i = 0; i < eventCount / 3; i++) {
+    lines.push('0 PttOpen', `0 StationTransceiversUpdated BENCH_${i % 8}_TWR`, '0 PttClosed');
+}
+writeFileSync(scriptPath, lines.join('\n'));
+
+TrackAudioAfv.Bootstrap(workDir);
+
+let received = 0;
+let batchCount = 0;
+let callbackNs = 0n;
+// Read every argument the way the main process handlers do, so the values are materialised
+let checksum = 0;
+
+TrackAudioAfv.RegisterCallback((events) => {
+    const start = process.hrtime.bigint();
+    for (const [name, arg1, arg2] of events) {
+        if (name === 'PttState') {
+            checksum += arg1 === true ? 1 : 0;
+        } else if (name === 'StationTransceiversUpdated') {
+            checksum += arg1.length + arg2;
+        }
+    }
+    callbackNs += process.hrtime.bigint() - start;
+    received += events.length;
+    batchCount++;
+});
+
+const start = process.hrtime.bigint();
+let elapsedNs = 0n;
+// The injector plays the whole timeline without waiting at speed 0, every fired event ends up
+// either delivered or replaced by a newer value of the same key
+await new Promise((resolve, reject) => {
+    const timeout = setTimeout(() => {
+        clearInterval(poll);
+        reject(new Error(`Timed out after ${timeoutMs} ms with ${received} events delivered`));
+    }, timeoutMs);
+    const poll = setInterval(() => {
+        const stats = TrackAudioAfv.GetEventQueueStats();
+        if (stats.delivered + stats.coalesced >= lines.length && stats.pending === 0) {
+            elapsedNs = process.hrtime.bigint() - start;
+            clearInterval(poll);
+            clearTimeout(timeout);
+            resolve();
+        }
+    }, 1);
+    TrackAudioAfv.RunAfvEventScript(scriptPath, 0);
+});
+
+const stats = TrackAudioAfv.GetEventQueueStats();
+console.log(`fired       ${lines.length} events`);
+console.log(`delivered   ${received} events in ${batchCount} batches (${stats.coalesced} coalesced)`);
+console.log(`wall time   ${(Number(elapsedNs) / 1e6).toFixed(1)} ms, 1 ms polling granularity`);
+console.log(`per event   ${(Number(elapsedNs) / lines.length).toFixed(0)} ns fired to handled`);
+console.log(`in callback ${(Number(callbackNs) / Math.max(received, 1)).toFixed(0)} ns/event`);
+console.log(`checksum    ${checksum}`);
+
+TrackAudioAfv.Exit();
+rmSync(workDir, { recursive: true, force: true });
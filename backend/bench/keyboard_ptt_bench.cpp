@@ -0,0 +1,69 @@
+// Measures the keyboard hook's check of whether a key is a PTT key.
+//
+// Compares the lock-free KeyboardPttKeys snapshot InputHandler reads for every key of the system
+// with the previous check, which took the InputHandler mutex to read the bindings. The keys
+// cycle through 32 codes of which 2 are bound, like typing with the PTT on a function key.
+//
+// Usage: keyboard_ptt_bench [events=50000000]
+#include "KeyboardPttKeys.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+
+#ifdef _MSC_VER
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+std::atomic<KeyboardPttKeys> keyboardPttKeys { KeyboardPttKeys { 57, 58 } };
+
+std::mutex m;
+int pttKey1 = 57;
+int pttKey2 = 58;
+
+BENCH_NOINLINE int SnapshotPttIndex(int keycode)
+{
+    return keyboardPttKeys.load(std::memory_order_acquire).pttIndexOf(keycode);
+}
+
+BENCH_NOINLINE int LockedPttIndex(int keycode)
+{
+    std::lock_guard<std::mutex> lock(m);
+    if (pttKey1 == -1) {
+        return 0;
+    }
+    if (keycode == pttKey1) {
+        return 1;
+    }
+    return keycode == pttKey2 ? 2 : 0;
+}
+
+template <typename Check> double NanosecondsPerEvent(Check check, int eventCount)
+{
+    volatile int sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < eventCount; i++) {
+        sink = sink + check(i & 31);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / eventCount;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int eventCount = argc > 1 ? std::atoi(argv[1]) : 50000000;
+    if (eventCount < 1) {
+        std::cerr << "Usage: keyboard_ptt_bench [events]\n";
+        return 1;
+    }
+
+    std::cout << "events   " << eventCount << "\n";
+    std::cout << "snapshot " << NanosecondsPerEvent(SnapshotPttIndex, eventCount) << " ns/event\n";
+    std::cout << "mutex    " << NanosecondsPerEvent(LockedPttIndex, eventCount) << " ns/event\n";
+    return 0;
+}
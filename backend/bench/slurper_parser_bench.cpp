@@ -0,0 +1,64 @@
+// Measures SlurperParser::parse on a large response.
+//
+// The response holds many connections that are not picked, with the ATC connection on the last
+// line, so every line is scanned. The slurper serves a handful of lines for a CID, this is the
+// worst case of a response listing far more.
+//
+// Usage: slurper_parser_bench [lines=100000] [iterations=200]
+#include "SlurperParser.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+std::string MakeResponse(int lineCount)
+{
+    std::string response;
+    for (int i = 0; i < lineCount - 1; i++) {
+        auto callsign = "DLH" + std::to_string(i);
+        // Alternate pilots, which are skipped, and ATIS, which are filtered out
+        if (i % 2 == 0) {
+            response += "1234567," + callsign + "," + callsign + ",pilot,0,50.0333,8.5706\n";
+        } else {
+            response += "1234567,EDDF_ATIS,EDDF_ATIS,118.025,0,50.0333,8.5706\n";
+        }
+    }
+    response += "1234567,EDDF_TWR,EDDF_TWR,119.900,0,50.0333,8.5706\n";
+    return response;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int lineCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (lineCount < 1 || iterations < 1) {
+        std::cerr << "Usage: slurper_parser_bench [lines] [iterations]\n";
+        return 1;
+    }
+
+    auto response = MakeResponse(lineCount);
+
+    // Keeps the results alive so the calls are not optimised out
+    int64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        auto connection = SlurperParser::parse(response);
+        checksum += connection ? connection->frequency : 0;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto totalNs = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    auto totalLines = static_cast<double>(lineCount) * iterations;
+    auto totalBytes = static_cast<double>(response.size()) * iterations;
+
+    std::cout << "lines      " << lineCount << " (" << response.size() << " bytes)\n";
+    std::cout << "iterations " << iterations << "\n";
+    std::cout << "per parse  " << totalNs / iterations / 1e3 << " us\n";
+    std::cout << "per line   " << totalNs / totalLines << " ns\n";
+    std::cout << "throughput " << totalBytes / totalNs * 1e3 << " MB/s\n";
+    std::cout << "checksum   " << checksum << "\n";
+    return 0;
+}
@@ -0,0 +1,68 @@
+// Fuzz target for SlurperParser::parse, the only code reading the slurper responses.
+//
+// Built with libFuzzer and the sanitizers when the compiler is clang, run it on the seed corpus:
+//   ./slurper_parser_fuzzer ../fuzz/corpus/slurper
+// Other compilers get a driver replaying the files given on the command line, or stdin.
+#include "SlurperParser.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    std::string_view body(reinterpret_cast<const char*>(data), size);
+    try {
+        auto connection = SlurperParser::parse(body);
+        if (!connection) {
+            return 0;
+        }
+
+        // The callsign must view into the body, it is copied into the session afterwards
+        if (connection->callsign.data() < body.data()
+            || connection->callsign.data() + connection->callsign.size()
+                > body.data() + body.size()) {
+            std::abort();
+        }
+        if (connection->frequency < 0) {
+            std::abort();
+        }
+    } catch (const std::invalid_argument&) {
+        // An unreadable coordinate, RemoteData reports it as a slurper error
+    }
+    return 0;
+}
+
+#ifdef TRACKAUDIO_STANDALONE_FUZZER
+namespace {
+void RunInput(std::istream& input)
+{
+    std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        RunInput(std::cin);
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        std::ifstream file(argv[i], std::ios::binary);
+        if (!file) {
+            std::cerr << "Cannot open " << argv[i] << "\n";
+            return 1;
+        }
+        RunInput(file);
+    }
+    std::cout << "Ran " << argc - 1 << " input(s)\n";
+    return 0;
+}
+#endif
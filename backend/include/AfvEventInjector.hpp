@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class AfvScriptedEventType : std::uint8_t {
+    kVoiceServerConnected,
+    kVoiceServerDisconnected,
+    kVoiceServerConnectionDegraded,
+    kVoiceServerConnectionResumed,
+    kFrequencyRxBegin,
+    kFrequencyRxEnd,
+    kStationRxBegin,
+    kStationRxEnd,
+    kPttOpen,
+    kPttClosed,
+    kStationTransceiversUpdated,
+    kAudioDeviceStoppedError,
+};
+
+/**
+ * @brief A single AFV event on a scripted timeline.
+ *
+ * Only the fields relevant to the event type are used: frequency for Rx events, callsign and
+ * activeTransmitters for station Rx events, name for the station or device name.
+ */
+struct AfvScriptedEvent {
+    std::chrono::milliseconds offset { 0 };
+    AfvScriptedEventType type = AfvScriptedEventType::kPttOpen;
+    unsigned int frequency = 0;
+    std::string callsign;
+    std::vector<std::string> activeTransmitters;
+    std::string name;
+};
+
+/**
+ * @brief Fires AFV events on the afv-native EventBus following a scripted timeline.
+ *
+ * Used together with FakeAtcClient to run the backend under synthetic traffic. A script is a
+ * text file with one event per line, `<offsetMs> <EventName> [arguments...]`, for example:
+ *
+ *   0    VoiceServerConnected
+ *   100  StationRxBegin 118700000 AFR123 AFR123,BAW45
+ *   2100 StationRxEnd 118700000 AFR123 BAW45
+ *   2500 PttOpen
+ *
+ * Blank lines and lines starting with '#' are ignored.
+ */
+class AfvEventInjector {
+public:
+    AfvEventInjector() = default;
+    ~AfvEventInjector();
+
+    AfvEventInjector(const AfvEventInjector&) = delete;
+    AfvEventInjector(AfvEventInjector&&) = delete;
+    AfvEventInjector& operator=(const AfvEventInjector&) = delete;
+    AfvEventInjector& operator=(AfvEventInjector&&) = delete;
+
+    /**
+     * @brief Parses a timeline script.
+     *
+     * @param script The script contents.
+     * @return The events sorted by offset.
+     * @throws std::invalid_argument on malformed lines.
+     */
+    static std::vector<AfvScriptedEvent> parseScript(const std::string& script);
+    static std::vector<AfvScriptedEvent> loadScript(const std::filesystem::path& path);
+
+    /**
+     * @brief Plays a timeline on a background thread, replacing any timeline already running.
+     *
+     * @param timeline The events to fire, offsets are relative to the start of playback.
+     * @param speed Playback speed multiplier, 2.0 plays twice as fast. 0 fires without waiting.
+     * @param repeat How many times to play the timeline back to back.
+     */
+    void start(std::vector<AfvScriptedEvent> timeline, double speed = 1.0, int repeat = 1);
+    void stop();
+    [[nodiscard]] bool isRunning() const { return running.load(); }
+
+    /**
+     * @brief Publishes a single event on the EventBus immediately.
+     */
+    static void fire(const AfvScriptedEvent& event);
+
+private:
+    void run(std::vector<AfvScriptedEvent> timeline, double speed, int repeat);
+
+    std::thread worker;
+    std::mutex m;
+    std::condition_variable cv;
+    bool stopRequested = false;
+    std::atomic<bool> running { false };
+};
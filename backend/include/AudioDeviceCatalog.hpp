@@ -0,0 +1,89 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Device id, device name, whether it is the default device
+using AudioDeviceInfo = std::tuple<std::string, std::string, bool>;
+
+struct AudioDeviceCatalogSource {
+    std::function<std::map<unsigned int, std::string>()> listApis;
+    std::function<std::vector<AudioDeviceInfo>(unsigned int apiId, bool isInput)> listDevices;
+    // Periodic change checks are skipped while this returns true, e.g. while audio is running
+    std::function<bool()> isBusy;
+};
+
+struct AudioApiList {
+    std::map<unsigned int, std::string> apis;
+    bool refreshing = false;
+};
+
+struct AudioDeviceList {
+    std::vector<AudioDeviceInfo> devices;
+    bool refreshing = false;
+};
+
+/**
+ * @brief Caches the audio APIs and devices, enumerating them on a background thread.
+ *
+ * Everything is enumerated once at construction, lookups then return the cached lists right
+ * away along with whether a refresh is underway. The cache is refreshed on invalidate(), e.g.
+ * when a device stops, and the last requested API is re-enumerated periodically to pick up
+ * hot-plugged devices. onChanged is called from the worker thread whenever a list changed.
+ */
+class AudioDeviceCatalog {
+public:
+    AudioDeviceCatalog(AudioDeviceCatalogSource source, std::function<void()> onChanged);
+    AudioDeviceCatalog(const AudioDeviceCatalog&) = delete;
+    AudioDeviceCatalog(AudioDeviceCatalog&&) = delete;
+    AudioDeviceCatalog& operator=(const AudioDeviceCatalog&) = delete;
+    AudioDeviceCatalog& operator=(AudioDeviceCatalog&&) = delete;
+    ~AudioDeviceCatalog();
+
+    AudioApiList apis();
+    AudioDeviceList devices(unsigned int apiId, bool isInput);
+
+    /**
+     * @brief Like devices(), but waits up to timeout for a list that is not cached yet.
+     */
+    AudioDeviceList awaitDevices(
+        unsigned int apiId, bool isInput, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Re-enumerates every API and device in the background, the current lists are
+     * returned until then.
+     */
+    void invalidate();
+
+private:
+    using DeviceKey = std::pair<unsigned int, bool>;
+
+    void run();
+    bool isRefreshing(unsigned int apiId) const;
+
+    static constexpr auto kChangeCheckInterval = std::chrono::seconds(30);
+
+    AudioDeviceCatalogSource source;
+    std::function<void()> onChanged;
+
+    mutable std::mutex m;
+    std::condition_variable cv;
+    std::optional<std::map<unsigned int, std::string>> cachedApis;
+    std::map<DeviceKey, std::vector<AudioDeviceInfo>> cachedDevices;
+    std::set<unsigned int> pendingApis;
+    std::set<unsigned int> refreshingApis;
+    std::optional<unsigned int> lastRequestedApi;
+    bool refreshAll = true;
+    bool refreshingAll = false;
+    bool stopRequested = false;
+    std::thread worker;
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Lock-free bounded multi-producer multi-consumer queue.
+ *
+ * Dmitry Vyukov's bounded MPMC queue: every cell carries a sequence number that tells producers
+ * and consumers whether it is free or filled, so neither side ever takes a lock. Pushing to a
+ * full queue fails instead of blocking, leaving the overflow policy to the caller.
+ *
+ * @tparam T Default constructible, move assignable element type.
+ */
+template <typename T> class BoundedMpmcQueue {
+public:
+    /**
+     * @param capacity Number of cells, rounded up to the next power of two.
+     */
+    explicit BoundedMpmcQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1U;
+        }
+        mask = size - 1;
+        buffer = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; i++) {
+            buffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+    BoundedMpmcQueue(BoundedMpmcQueue&&) = delete;
+    BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+    BoundedMpmcQueue& operator=(BoundedMpmcQueue&&) = delete;
+    ~BoundedMpmcQueue() = default;
+
+    /**
+     * @return false if the queue is full, in which case value is left untouched.
+     */
+    bool tryPush(T&& value)
+    {
+        Cell* cell = nullptr;
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &buffer[pos & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @return false if the queue is empty.
+     */
+    bool tryPop(T& value)
+    {
+        Cell* cell = nullptr;
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &buffer[pos & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff
+                = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->data);
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @return An approximation of the number of queued elements, exact when quiescent.
+     */
+    [[nodiscard]] size_t sizeApprox() const
+    {
+        auto enqueued = enqueuePos.load(std::memory_order_relaxed);
+        auto dequeued = dequeuePos.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    [[nodiscard]] size_t capacity() const { return mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence { 0 };
+        T data {};
+    };
+
+    static constexpr size_t kCacheLineSize = 64;
+
+    std::unique_ptr<Cell[]> buffer;
+    size_t mask = 0;
+    alignas(kCacheLineSize) std::atomic<size_t> enqueuePos { 0 };
+    alignas(kCacheLineSize) std::atomic<size_t> dequeuePos { 0 };
+};
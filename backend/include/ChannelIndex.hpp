@@ -0,0 +1,95 @@
+#pragma once
+#include "RadioSimulation.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+
+/**
+ * @brief Maps the VHF airband channels to a dense index.
+ *
+ * Covers every 5 kHz channel name from 118.000 to 136.990 MHz that is valid under the 8.33 kHz
+ * naming rules of RadioSimulation, which includes all the 25 kHz channels. Each 100 kHz block
+ * has 20 such names of which 4 (x.x20, x.x45, x.x70, x.x95) are never used, so a block takes
+ * 16 indices.
+ */
+class ChannelIndex {
+public:
+    static constexpr int kFirstChannelKHz = 118000;
+    static constexpr int kLastChannelKHz = 136990;
+    static constexpr int kChannelsPerBlock = 16;
+    static constexpr size_t kCount
+        = static_cast<size_t>((kLastChannelKHz - kFirstChannelKHz) / 100 + 1) * kChannelsPerBlock;
+
+    /**
+     * @brief The index of a channel, nullopt outside the band or off the channel raster.
+     */
+    static std::optional<uint16_t> fromFrequency(unsigned int frequencyHz)
+    {
+        if (frequencyHz % 5000 != 0) {
+            return std::nullopt;
+        }
+        int fKHz = static_cast<int>(frequencyHz / 1000);
+        if (fKHz < kFirstChannelKHz || fKHz > kLastChannelKHz
+            || !RadioSimulation::isValid8_33kHzChannel(fKHz)) {
+            return std::nullopt;
+        }
+
+        int slot = (fKHz - kFirstChannelKHz) / 5;
+        int block = slot / 20;
+        int slotInBlock = slot % 20;
+        // Skip the unused x.x20, x.x45 and x.x70 names below this slot
+        int rank = slotInBlock - (slotInBlock > 4) - (slotInBlock > 9) - (slotInBlock > 14);
+        return static_cast<uint16_t>(block * kChannelsPerBlock + rank);
+    }
+};
+
+/**
+ * @brief Per-channel station volumes that can be read and written from any thread without a
+ * lock. Frequencies outside ChannelIndex fall back to a small map behind a mutex.
+ */
+class ChannelVolumeTable {
+public:
+    ChannelVolumeTable()
+    {
+        for (auto& volume : volumes) {
+            volume.store(kUnset, std::memory_order_relaxed);
+        }
+    }
+
+    std::optional<float> get(unsigned int frequencyHz) const
+    {
+        if (auto index = ChannelIndex::fromFrequency(frequencyHz)) {
+            float volume = volumes[*index].load(std::memory_order_relaxed);
+            return std::isnan(volume) ? std::nullopt : std::optional<float>(volume);
+        }
+
+        std::lock_guard<std::mutex> lock(fallbackMutex);
+        auto it = fallbackVolumes.find(frequencyHz);
+        return it != fallbackVolumes.end() ? std::optional<float>(it->second) : std::nullopt;
+    }
+
+    void set(unsigned int frequencyHz, float volume)
+    {
+        if (auto index = ChannelIndex::fromFrequency(frequencyHz)) {
+            volumes[*index].store(volume, std::memory_order_relaxed);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(fallbackMutex);
+        fallbackVolumes.insert_or_assign(frequencyHz, volume);
+    }
+
+private:
+    static constexpr float kUnset = std::numeric_limits<float>::quiet_NaN();
+
+    std::array<std::atomic<float>, ChannelIndex::kCount> volumes;
+
+    mutable std::mutex fallbackMutex;
+    std::map<unsigned int, float> fallbackVolumes;
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief Runs a task on its own thread at most once per interval, however often it is requested.
+ *
+ * The first request runs the task straight away, requests made while it runs or during the
+ * following interval are folded into a single run at the end of that interval. The thread is
+ * started on the first request.
+ */
+class CoalescingTask {
+public:
+    CoalescingTask(std::chrono::milliseconds interval, std::function<void()> task)
+        : interval(interval)
+        , task(std::move(task))
+    {
+    }
+    CoalescingTask(const CoalescingTask&) = delete;
+    CoalescingTask(CoalescingTask&&) = delete;
+    CoalescingTask& operator=(const CoalescingTask&) = delete;
+    CoalescingTask& operator=(CoalescingTask&&) = delete;
+    ~CoalescingTask() { stop(); }
+
+    void request()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            if (stopRequested) {
+                return;
+            }
+            pending = true;
+            if (!worker.joinable()) {
+                worker = std::thread(&CoalescingTask::run, this);
+            }
+        }
+        cv.notify_all();
+    }
+
+    /**
+     * @brief Drops any pending request and joins the thread, later requests are ignored.
+     */
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopRequested = true;
+            pending = false;
+        }
+        cv.notify_all();
+
+        if (worker.joinable() && worker.get_id() != std::this_thread::get_id()) {
+            worker.join();
+        }
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        while (true) {
+            cv.wait(lock, [this] { return stopRequested || pending; });
+            if (stopRequested) {
+                return;
+            }
+            pending = false;
+
+            lock.unlock();
+            task();
+            lock.lock();
+
+            // Hold off the next run for one interval, requests made meanwhile are folded into it
+            if (cv.wait_for(lock, interval, [this] { return stopRequested; })) {
+                return;
+            }
+        }
+    }
+
+    const std::chrono::milliseconds interval;
+    const std::function<void()> task;
+
+    std::mutex m;
+    std::condition_variable cv;
+    bool pending = false;
+    bool stopRequested = false;
+    std::thread worker;
+};
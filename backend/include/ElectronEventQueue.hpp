@@ -0,0 +1,104 @@
+#pragma once
+#include "BoundedMpmcQueue.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <napi.h>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+inline constexpr size_t kMaxElectronEventArgs = 3;
+
+using ElectronEventArg = std::variant<std::monostate, std::string, double, bool,
+    std::vector<std::string>, nlohmann::json>;
+
+struct ElectronEvent {
+    std::string name;
+    std::array<ElectronEventArg, kMaxElectronEventArgs> args;
+    // Push order across all policies and producers, set by ElectronEventQueue::push
+    uint64_t sequence = 0;
+};
+
+enum class ElectronEventPolicy : std::uint8_t {
+    // Delivered in order and never lost, spilling to an unbounded list if the queue is full
+    kOrdered,
+    // Only the most recent value per key is delivered
+    kLatest,
+    // Dropped if the queue is full
+    kBestEffort,
+};
+
+struct ElectronEventQueueStats {
+    uint64_t delivered = 0;
+    uint64_t batches = 0;
+    uint64_t coalesced = 0;
+    uint64_t dropped = 0;
+    uint64_t spilled = 0;
+    size_t pending = 0;
+};
+
+/**
+ * @brief Delivers backend events to the JS callback in batches.
+ *
+ * Producers push to a bounded queue and the first one to find no flush pending schedules a
+ * single call on the JS thread, which drains up to kMaxBatchSize events into one array. A batch
+ * therefore waits at most one libuv tick, and the ThreadSafeFunction never holds more than one
+ * pending call.
+ *
+ * Each event name has a policy: latest-value events are coalesced per key so a stalled JS thread
+ * only sees the last value, ordered events are never dropped, best-effort events are dropped
+ * when the queue is full. A coalesced value is delivered at the position of its last push among
+ * the other events, so a station state never overtakes e.g. the removal that followed it. The
+ * order is the one in which push() returned, across all producer threads.
+ */
+class ElectronEventQueue {
+public:
+    // The ThreadSafeFunction only ever has one flush queued, leave room for one in progress
+    static constexpr size_t kCallbackQueueSize = 2;
+
+    static void push(ElectronEvent&& event);
+    static ElectronEventQueueStats stats();
+    static ElectronEventPolicy policyFor(std::string_view eventName);
+
+private:
+    static void scheduleFlush();
+    static void flush(Napi::Env env, Napi::Function jsCallback);
+    static bool hasPendingEvents();
+    // Takes the latest values pushed before the given sequence, sorted by sequence
+    static std::vector<ElectronEvent> takeLatestEvents(uint64_t beforeSequence);
+    static std::string coalesceKey(const ElectronEvent& event);
+    static Napi::Array toNapi(Napi::Env env, const ElectronEvent& event);
+
+    static constexpr size_t kQueueCapacity = 1024;
+    static constexpr size_t kMaxBatchSize = 256;
+
+    inline static BoundedMpmcQueue<ElectronEvent> pendingEvents { kQueueCapacity };
+    inline static std::atomic<bool> flushScheduled = false;
+
+    // Held while an event is numbered and queued, and while flush() takes a batch. Taken before
+    // spillMutex and latestMutex.
+    inline static std::mutex pushMutex;
+    inline static uint64_t nextSequence = 0;
+
+    // Ordered events that did not fit in the queue, drained once the queue is empty. While it is
+    // not empty every ordered event goes here so the delivery order is kept.
+    inline static std::mutex spillMutex;
+    inline static std::deque<ElectronEvent> spilledEvents;
+    inline static std::atomic<bool> hasSpilledEvents = false;
+
+    inline static std::mutex latestMutex;
+    inline static std::map<std::string, ElectronEvent> latestEvents;
+
+    inline static std::atomic<uint64_t> delivered = 0;
+    inline static std::atomic<uint64_t> batches = 0;
+    inline static std::atomic<uint64_t> coalesced = 0;
+    inline static std::atomic<uint64_t> dropped = 0;
+    inline static std::atomic<uint64_t> spilled = 0;
+};
@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A PTT bound to a joystick button, identified the way SFML reports the joystick.
+ */
+struct JoystickPttBinding {
+    int pttIndex = 0;
+    std::string deviceName;
+    unsigned int vendorId = 0;
+    unsigned int productId = 0;
+    // Button index as numbered by SFML, which on Linux is the numbering of the joydev driver
+    int button = 0;
+};
+
+/**
+ * @brief Listens for joystick PTT buttons on the Linux evdev devices.
+ *
+ * Blocks on the /dev/input/event* devices of the bound joysticks with epoll, so a button press is
+ * handled as soon as the kernel reports it instead of on the next SFML poll. Only available on
+ * Linux and when the devices are readable by the user, start() fails otherwise and joysticks
+ * are left to the SFML polling.
+ */
+class EvdevJoystickMonitor {
+public:
+    // Called from the monitor thread with the age of the kernel event when it is handled
+    using ButtonCallback
+        = std::function<void(int pttIndex, bool isPressed, std::chrono::microseconds eventAge)>;
+    // Called from the monitor thread once it stopped listening because a device went away, it
+    // must not call stop()
+    using DisconnectCallback = std::function<void()>;
+
+    EvdevJoystickMonitor(ButtonCallback onButton, DisconnectCallback onDisconnect);
+    ~EvdevJoystickMonitor();
+
+    EvdevJoystickMonitor(const EvdevJoystickMonitor&) = delete;
+    EvdevJoystickMonitor(EvdevJoystickMonitor&&) = delete;
+    EvdevJoystickMonitor& operator=(const EvdevJoystickMonitor&) = delete;
+    EvdevJoystickMonitor& operator=(EvdevJoystickMonitor&&) = delete;
+
+    /**
+     * @brief Opens the devices of the bindings and starts listening, stopping any previous run.
+     *
+     * @return false, with nothing started, when evdev is unavailable or a binding has no single
+     * readable device matching it.
+     */
+    bool start(const std::vector<JoystickPttBinding>& bindings);
+    void stop();
+
+    [[nodiscard]] bool isRunning() const { return running; }
+
+private:
+    struct BoundButton {
+        uint16_t code = 0;
+        int pttIndex = 0;
+    };
+
+    struct BoundDevice {
+        int fd = -1;
+        std::string path;
+        std::vector<BoundButton> buttons;
+    };
+
+    void run();
+    bool readEvents(BoundDevice& device);
+    void resyncButtons(const BoundDevice& device);
+    void closeDevices();
+
+    ButtonCallback onButton;
+    DisconnectCallback onDisconnect;
+
+    std::vector<BoundDevice> devices;
+    int epollFd = -1;
+    int wakeFd = -1;
+    std::thread worker;
+    std::atomic<bool> running { false };
+};
@@ -0,0 +1,154 @@
+#pragma once
+#include "afv-native/afv/dto/StationTransceiver.h"
+#include "afv-native/atcClientWrapper.h"
+#include "afv-native/hardwareType.h"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/**
+ * @brief Radio state kept by FakeAtcClient for every added frequency.
+ *
+ * Mirrors the fields of afv-native's ClientRadioState that the backend reads, so callers that
+ * iterate getRadioState() with structured bindings work against either client.
+ */
+struct FakeRadioState {
+    std::string stationName;
+    bool rx = false;
+    bool tx = false;
+    bool xc = false;
+    bool crossCoupleAcross = false;
+    bool onHeadset = true;
+    bool isOutputMuted = false;
+    float gain = 1.0f;
+};
+
+/**
+ * @brief In-memory stand-in for afv_native::api::atcClient.
+ *
+ * Implements the subset of the atcClient interface used by the backend without touching audio
+ * hardware or the AFV network. Connection, PTT and transceiver calls publish the same events on
+ * the afv-native EventBus as the real client would, so the HandleAfvEvents handlers, RadioHelper
+ * and the SDK can be driven deterministically. Selected at build time with TRACKAUDIO_FAKE_AFV.
+ */
+class FakeAtcClient {
+public:
+    explicit FakeAtcClient(std::string clientName, std::string resourcePath = "",
+        std::string baseUrl = "");
+
+    // Connection
+    bool Connect();
+    void Disconnect();
+    bool IsVoiceConnected() const;
+    void SetCallsign(const std::string& callsign);
+    void SetCredentials(const std::string& username, const std::string& password);
+    void SetClientPosition(double lat, double lon, double amslm, double aglm);
+
+    // Audio
+    std::map<unsigned int, std::string> GetAudioApis();
+    std::vector<std::tuple<std::string, std::string, bool>> GetAudioInputDevices(
+        unsigned int apiId);
+    std::vector<std::tuple<std::string, std::string, bool>> GetAudioOutputDevices(
+        unsigned int apiId);
+    void SetAudioApi(unsigned int apiId);
+    void SetAudioInputDevice(const std::string& deviceId);
+    void SetAudioOutputDevice(const std::string& deviceId);
+    void SetAudioSpeakersOutputDevice(const std::string& deviceId);
+    void StartAudio();
+    void StopAudio();
+    bool IsAudioRunning() const;
+    double GetInputVu() const;
+    double GetInputPeak() const;
+    void SetMicrophoneVolume(float volume);
+    void SetEnableInputFilters(bool enabled);
+    void SetEnableOutputEffects(bool enabled);
+    void SetHardware(afv_native::HardwareType hardware);
+    void PlayAdHocSound(const std::string& wavFilePath, float gain,
+        afv_native::AdHocOutputTarget target);
+    void StopAdHocSounds();
+    void SetLoopback(bool enabled, afv_native::AdHocOutputTarget target, float gain,
+        afv_native::HardwareType hardware);
+
+    // Radios
+    bool AddFrequency(unsigned int frequency, const std::string& stationName = "");
+    void RemoveFrequency(unsigned int frequency);
+    bool IsFrequencyActive(unsigned int frequency);
+    std::map<unsigned int, FakeRadioState> getRadioState();
+    void reset();
+
+    void SetRx(unsigned int frequency, bool active);
+    void SetTx(unsigned int frequency, bool active);
+    void SetXc(unsigned int frequency, bool active);
+    void SetCrossCoupleAcross(unsigned int frequency, bool active);
+    void SetOnHeadset(unsigned int frequency, bool onHeadset);
+    void SetOutputMute(unsigned int frequency, bool muted);
+    void SetRadioGain(unsigned int frequency, float gain);
+
+    bool GetRxState(unsigned int frequency);
+    bool GetTxState(unsigned int frequency);
+    bool GetXcState(unsigned int frequency);
+    bool GetCrossCoupleAcrossState(unsigned int frequency);
+    bool GetOnHeadset(unsigned int frequency);
+    bool GetIsOutputMutedState(unsigned int frequency);
+    float GetOutputGainState(unsigned int frequency);
+
+    void SetPtt(bool pttState);
+
+    // Stations and transceivers
+    void GetStation(const std::string& callsign);
+    void FetchStationVccs(const std::string& callsign);
+    void FetchTransceiverInfo(const std::string& station);
+    void UseTransceiversFromStation(const std::string& station, int frequency);
+    int GetTransceiverCountForStation(const std::string& station);
+    std::map<std::string, std::vector<afv_native::afv::dto::StationTransceiver>> GetTransceivers();
+    void SetManualTransceivers(
+        unsigned int frequency, const std::vector<afv_native::afv::dto::StationTransceiver>& tx);
+
+    /**
+     * @brief Seeds the transceivers returned for a station, as if fetched from the AFV API.
+     *
+     * @param station The station callsign.
+     * @param transceivers The transceivers to report for the station.
+     * @param notify Whether to publish a StationTransceiversUpdatedEvent.
+     */
+    void SetStationTransceivers(const std::string& station,
+        std::vector<afv_native::afv::dto::StationTransceiver> transceivers, bool notify = true);
+
+    /**
+     * @brief Returns the transceivers last pushed with SetManualTransceivers for a frequency.
+     */
+    std::vector<afv_native::afv::dto::StationTransceiver> GetManualTransceivers(
+        unsigned int frequency);
+
+private:
+    // Setters and getters on a frequency that was never added are ignored, as in afv-native.
+    template <typename T> void setField(unsigned int frequency, T FakeRadioState::*field, T value)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        auto it = radioStates.find(frequency);
+        if (it != radioStates.end()) {
+            it->second.*field = value;
+        }
+    }
+
+    template <typename T> T getField(unsigned int frequency, T FakeRadioState::*field, T fallback)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        auto it = radioStates.find(frequency);
+        return it != radioStates.end() ? it->second.*field : fallback;
+    }
+
+    mutable std::mutex m;
+    std::map<unsigned int, FakeRadioState> radioStates;
+    std::map<std::string, std::vector<afv_native::afv::dto::StationTransceiver>> transceivers;
+    std::map<unsigned int, std::vector<afv_native::afv::dto::StationTransceiver>>
+        manualTransceivers;
+
+    std::string callsign;
+    std::atomic<bool> voiceConnected { false };
+    std::atomic<bool> audioRunning { false };
+    std::atomic<bool> pttOpen { false };
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include "CoalescingTask.hpp"
+#include "afv-native/afv/dto/StationTransceiver.h"
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+using StationTransceiverList = std::vector<afv_native::afv::dto::StationTransceiver>;
+
+struct GuardUnicomTransceiverSource {
+    // Callsigns of the stations currently received, excluding GUARD and UNICOM themselves
+    std::function<std::set<std::string>()> listRxStations;
+    std::function<std::map<std::string, StationTransceiverList>()> listTransceivers;
+    // Pushes the transceivers to GUARD and UNICOM
+    std::function<void(const StationTransceiverList&)> upload;
+};
+
+/**
+ * @brief Keeps the GUARD and UNICOM transceivers set to those of every received station.
+ *
+ * The transceivers are cached per station and only the stations reported as updated are read
+ * again. Updates are coalesced on a background thread so a position bringing up many stations at
+ * once leads to a handful of uploads, and nothing is uploaded when the combined set is unchanged.
+ */
+class GuardUnicomTransceivers {
+public:
+    explicit GuardUnicomTransceivers(GuardUnicomTransceiverSource source);
+    GuardUnicomTransceivers(const GuardUnicomTransceivers&) = delete;
+    GuardUnicomTransceivers(GuardUnicomTransceivers&&) = delete;
+    GuardUnicomTransceivers& operator=(const GuardUnicomTransceivers&) = delete;
+    GuardUnicomTransceivers& operator=(GuardUnicomTransceivers&&) = delete;
+    ~GuardUnicomTransceivers() = default;
+
+    /**
+     * @brief Re-reads the transceivers of a station, e.g. on a StationTransceiversUpdatedEvent.
+     */
+    void stationUpdated(const std::string& station);
+
+    /**
+     * @brief Re-checks which stations are received, e.g. after a frequency was removed.
+     */
+    void refresh();
+
+    /**
+     * @brief Uploads the set on the next update even if unchanged, for when GUARD or UNICOM lost
+     * their transceivers.
+     */
+    void invalidate();
+
+    /**
+     * @brief Stops the background updates, must be called before the client is destroyed.
+     */
+    void stop();
+
+private:
+    void update();
+
+    static constexpr auto kUpdateInterval = std::chrono::milliseconds(250);
+
+    GuardUnicomTransceiverSource source;
+
+    std::mutex m;
+    std::set<std::string> updatedStations;
+    bool uploadRequired = true;
+
+    // Only used from the update thread
+    std::map<std::string, StationTransceiverList> cachedTransceivers;
+    StationTransceiverList uploadedTransceivers;
+
+    // Last so the thread is joined before the state above is destroyed
+    CoalescingTask updateTask;
+};
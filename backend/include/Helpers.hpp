@@ -1,4 +1,5 @@
 #pragma once
+#include "ElectronEventQueue.hpp"
 #include "RadioSimulation.h"
 #include "Shared.hpp"
 
@@ -10,6 +11,8 @@
 #include <plog/Log.h>
 #include <sago/platform_folders.h>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 class Helpers {
 public:
@@ -109,44 +112,27 @@ public:
         NapiHelpers::callbackAvailable = true;
     }
 
-    static void callElectron(const std::string& eventName, const std::string& data = "",
-        const std::string& data2 = "", const std::string& data3 = "")
+    /**
+     * @brief Sends an event to the Electron main thread.
+     *
+     * Arguments keep their type on the JS side: strings, numbers, booleans, string arrays and
+     * JSON objects are built as native JS values, so nothing needs to be parsed back.
+     *
+     * @param eventName The event name, see AfvEventTypes in bindings.js.
+     * @param args Up to three payload values.
+     */
+    template <typename... Args>
+    static void callElectron(const std::string& eventName, Args&&... args)
     {
-        if (!NapiHelpers::callbackAvailable || NapiHelpers::callbackRef == nullptr
-            || NapiHelpers::_requestExit.load()) {
-            return;
-        }
-
-        std::lock_guard<std::mutex> lock(_callElectronMutex);
+        static_assert(
+            sizeof...(Args) <= kMaxElectronEventArgs, "Too many arguments for an Electron event");
 
-        callbackRef->NonBlockingCall(
-            [eventName, data, data2, data3](Napi::Env env, Napi::Function jsCallback) {
-                PLOGV << "Event name: " << eventName << ", data: " << data << ", data2: " << data2
-                      << ", data3: " << data3;
-                jsCallback.Call({ Napi::String::New(env, eventName), Napi::String::New(env, data),
-                    Napi::String::New(env, data2), Napi::String::New(env, data3) });
-            });
-    }
-
-    static void callElectronWithStringArray(const std::string& eventName, const std::string& data,
-        const std::string& data2, const std::vector<std::string>& arr)
-    {
         if (!NapiHelpers::callbackAvailable || NapiHelpers::callbackRef == nullptr
             || NapiHelpers::_requestExit.load()) {
             return;
         }
 
-        std::lock_guard<std::mutex> lock(_callElectronMutex);
-
-        callbackRef->NonBlockingCall(
-            [eventName, data, data2, arr](Napi::Env env, Napi::Function jsCallback) {
-                auto napiArr = Napi::Array::New(env, arr.size());
-                for (size_t i = 0; i < arr.size(); i++) {
-                    napiArr[i] = Napi::String::New(env, arr[i]);
-                }
-                jsCallback.Call({ Napi::String::New(env, eventName), Napi::String::New(env, data),
-                    Napi::String::New(env, data2), napiArr });
-            });
+        ElectronEventQueue::push({ eventName, { toEventArg(std::forward<Args>(args))... } });
     }
 
     template <typename ResultType> class SimplePromiseWorker : public Napi::AsyncWorker {
@@ -239,6 +225,17 @@ public:
 
     static void sendErrorToElectron(const std::string& message) { callElectron("error", message); }
 
-    inline static std::mutex _callElectronMutex;
     inline static std::atomic<bool> _requestExit = false;
+
+private:
+    static ElectronEventArg toEventArg(const char* value) { return std::string(value); }
+    static ElectronEventArg toEventArg(std::string value) { return value; }
+    static ElectronEventArg toEventArg(bool value) { return value; }
+    static ElectronEventArg toEventArg(std::vector<std::string> value) { return value; }
+    static ElectronEventArg toEventArg(nlohmann::json value) { return value; }
+    template <typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+    static ElectronEventArg toEventArg(T value)
+    {
+        return static_cast<double>(value);
+    }
 };
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "EvdevJoystickMonitor.hpp"
+#include "KeyboardPttKeys.hpp"
 #include "KeycodeLookup.h"
+#include "PttLatency.hpp"
 #include "Shared.hpp"
 #include "UIOHookWrapper.h"
 
@@ -9,9 +12,12 @@
 #include <SFML/Window/Keyboard.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 class InputHandler {
 public:
@@ -31,22 +37,76 @@ public:
     static void forwardPttKeyName(int pttIndex);
     static std::string getPttKeyName(int pttIndex);
 
+    /**
+     * @brief Publishes the PTT keys from UserSettings to the keyboard hook, to be called
+     * whenever they were loaded or changed.
+     */
+    static void publishPttBindings();
+
 private:
     void handleKeyEvent(const uiohook_event* event);
     bool handlePttSetup(const uiohook_event* event);
     void checkKeyboardPtt(
-        int pttIndex, int pttKey, bool isJoystickButton, bool isKeyPressed, int keycode);
+        int pttIndex, bool isKeyPressed, std::chrono::steady_clock::time_point eventTime);
     void checkJoystickPtt(int pttIndex, int key, int joystickId);
+    // Returns whether the PTT changed
+    bool setJoystickPtt(int pttIndex, bool isButtonPressed, PttInputSource source,
+        std::chrono::steady_clock::time_point eventTime);
+    void pollJoysticks(bool isEvdevActive);
     bool handleJoystickSetup();
-    void onTimer(Poco::Timer& timer);
+    void onTimer(Poco::Timer& firedTimer);
+
+    // Hands the joystick PTT bindings to the evdev monitor whenever they changed, called from the
+    // timer without holding m, takes evdevMonitorMutex
+    void updateEvdevMonitor();
+    void handleEvdevButton(int pttIndex, bool isPressed, std::chrono::microseconds eventAge);
+    void handleEvdevDisconnect();
 
     static void updatePttKey(int pttIndex, int key, bool isJoystickButton, int joystickId = 0);
     static std::string lookupPttKeyName(int key, bool isJoystickButton, int joystickId);
 
+    // Joysticks are polled at kJoystickPollInterval while SFML has to be read, i.e. during the
+    // PTT setup or when a joystick PTT is not covered by the evdev monitor. Otherwise the timer
+    // only checks for changed bindings every kIdleInterval.
+    static constexpr long kJoystickPollInterval = 35;
+    static constexpr long kIdleInterval = 1000;
+    static constexpr auto kEvdevRetryInterval = std::chrono::seconds(5);
+
+    // The keyboard hook sees every key of the system and reads the PTT keys from this snapshot
+    // without locking, so that other keys are dismissed right away
+    inline static std::atomic<KeyboardPttKeys> keyboardPttKeys { KeyboardPttKeys {} };
+    static_assert(std::atomic<KeyboardPttKeys>::is_always_lock_free);
+
     // Member variables
     std::mutex m;
     Poco::Timer timer;
+    // Set under m by the destructor, the timer interval must not be changed past that point as
+    // Timer::stop() relies on it being 0
+    std::atomic<bool> isStopping { false };
+    std::chrono::steady_clock::time_point joystickPollTime;
+    std::chrono::steady_clock::time_point previousJoystickPoll;
     std::unique_ptr<UIOHookWrapper> uioHookWrapper_;
+    std::unique_ptr<EvdevJoystickMonitor> evdevMonitor;
+
+    struct JoystickButton {
+        int pttIndex = 0;
+        int joystickId = 0;
+        int button = 0;
+
+        bool operator==(const JoystickButton& other) const
+        {
+            return pttIndex == other.pttIndex && joystickId == other.joystickId
+                && button == other.button;
+        }
+    };
+
+    // Serialises starting and stopping the monitor between the timer and the destructor, taken
+    // before m
+    std::mutex evdevMonitorMutex;
+    // Only used from the timer thread
+    std::vector<JoystickButton> evdevButtons;
+    std::chrono::steady_clock::time_point evdevRetryAt;
+    std::atomic<bool> isEvdevLost { false };
 
     std::atomic<bool> isPttSetupRunning { false };
     std::atomic<int> pttSetupIndex { 0 };
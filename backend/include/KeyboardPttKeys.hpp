@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+// The keyboard keys of PTT 1 and 2, -1 when the PTT is not on the keyboard
+struct KeyboardPttKeys {
+    int32_t ptt1 = -1;
+    int32_t ptt2 = -1;
+
+    // 1 or 2 for the PTT bound to the key, 0 for any other key
+    [[nodiscard]] int pttIndexOf(int32_t keycode) const
+    {
+        if (keycode == ptt1) {
+            return 1;
+        }
+        return keycode == ptt2 ? 2 : 0;
+    }
+};
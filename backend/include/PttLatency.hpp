@@ -0,0 +1,88 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <nlohmann/json.hpp>
+
+enum class PttInputSource : std::uint8_t {
+    kKeyboard,
+    kJoystickEvdev,
+    kJoystickPoll,
+};
+
+// The stages of a PTT press in the order they happen
+enum class PttLatencyStage : std::uint8_t {
+    // The uiohook event, the evdev event timestamp or the SFML poll that saw the button
+    kInput,
+    // InputHandler decided to open the PTT, right before calling SetPtt
+    kDecision,
+    // mClient->SetPtt returned
+    kSetPtt,
+    // The PttOpenEvent reached the HandleAfvEvents handler
+    kAfvPttOpen,
+    // kTxBegin was broadcast to the SDK clients
+    kSdkTxBegin,
+};
+
+/**
+ * @brief Histogram of latencies on fixed, roughly logarithmic buckets from 50 us to 1 s.
+ */
+class LatencyHistogram {
+public:
+    void add(std::chrono::nanoseconds latency);
+    [[nodiscard]] nlohmann::json toJson() const;
+
+private:
+    // Upper bounds in microseconds, the last bucket counts everything above 1 s
+    static constexpr std::array<int64_t, 14> kBucketBoundsUs = { 50, 100, 250, 500, 1000, 2500,
+        5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000 };
+
+    // Upper bound of the bucket holding the given quantile, the maximum for the last bucket
+    [[nodiscard]] double quantileUs(double quantile) const;
+
+    std::array<uint64_t, kBucketBoundsUs.size() + 1> buckets {};
+    uint64_t count = 0;
+    int64_t totalNs = 0;
+    int64_t maxNs = 0;
+};
+
+/**
+ * @brief Measures where the time goes between a PTT press and the transmission starting.
+ *
+ * A sample starts when InputHandler opens the PTT and is timestamped on the steady clock at
+ * every later stage it reaches. Each stage adds the time since the previous one to its
+ * histogram, and the time from the input to the PttOpenEvent goes to the end-to-end histogram.
+ * Stages reached out of order, or more than kSampleTimeout after the input, are ignored so that
+ * a PTT opened from the SDK or the UI is not attributed to an earlier press.
+ */
+class PttLatency {
+public:
+    /**
+     * @brief Starts a sample for a PTT press decided now.
+     *
+     * @param source Where the press came from.
+     * @param eventTime When the input event happened, or was first seen when polling.
+     */
+    static void begin(PttInputSource source, std::chrono::steady_clock::time_point eventTime);
+    static void mark(PttLatencyStage stage);
+
+    static nlohmann::json report();
+    static void reset();
+
+private:
+    static constexpr size_t kStageCount = static_cast<size_t>(PttLatencyStage::kSdkTxBegin) + 1;
+    static constexpr size_t kSourceCount = static_cast<size_t>(PttInputSource::kJoystickPoll) + 1;
+    static constexpr auto kSampleTimeout = std::chrono::seconds(2);
+
+    inline static std::mutex m;
+    inline static bool isSampling = false;
+    inline static PttLatencyStage lastStage = PttLatencyStage::kInput;
+    inline static std::chrono::steady_clock::time_point inputTime;
+    inline static std::chrono::steady_clock::time_point lastStageTime;
+
+    // Indexed by the stage the latency ends at, kInput stays empty
+    inline static std::array<LatencyHistogram, kStageCount> stageLatencies;
+    inline static LatencyHistogram endToEnd;
+    inline static std::array<uint64_t, kSourceCount> samplesBySource {};
+};
@@ -1,10 +1,16 @@
 #pragma once
 
+#include "CoalescingTask.hpp"
 #include "Helpers.hpp"
 #include "Shared.hpp"
 #include "sdk.hpp"
+#include <cstdint>
+#include <map>
 #include <optional>
 #include <plog/Log.h>
+#include <set>
+#include <utility>
+#include <vector>
 
 class RadioState {
 public:
@@ -18,86 +24,234 @@ public:
     float outputVolume;
 };
 
+// Fields of a RadioState, as bits of RadioStateChange::changedFields
+namespace RadioStateField {
+inline constexpr uint8_t kRx = 1 << 0;
+inline constexpr uint8_t kTx = 1 << 1;
+inline constexpr uint8_t kXc = 1 << 2;
+inline constexpr uint8_t kXca = 1 << 3;
+inline constexpr uint8_t kHeadset = 1 << 4;
+inline constexpr uint8_t kOutputMuted = 1 << 5;
+inline constexpr uint8_t kOutputVolume = 1 << 6;
+// The fields reported by the legacy kFrequencyStateUpdate message
+inline constexpr uint8_t kRouting = kRx | kTx | kXc | kXca;
+} // namespace RadioStateField
+
+struct RadioStateChange {
+    // False when the radio does not exist or voice is not connected
+    bool applied = false;
+    uint8_t changedFields = 0;
+
+    [[nodiscard]] bool changed() const { return changedFields != 0; }
+    [[nodiscard]] bool has(uint8_t fields) const { return (changedFields & fields) != 0; }
+};
+
+/**
+ * @brief Collects the transceiver fetches and notifications of several SetRadioState calls so
+ * they are issued once by RadioHelper::FlushBatch.
+ */
+struct RadioStateBatch {
+    std::set<std::string> transceiverFetches;
+    // Frequency to station callsign, a frequency updated twice is notified once
+    std::map<int, std::string> updatedStations;
+    bool routingChanged = false;
+};
+
 class RadioHelper {
 public:
     /**
-     * @brief Set the state of a radio.
+     * @brief Set the state of a radio, only applying and notifying the fields that differ from
+     * its current state. Nothing is broadcast when no field changed.
      *
      * @param newState The state to set
-     * @return true The state was set successfully
-     * @return false The state was not set successfully
+     * @param batch When set, transceiver fetches and notifications are deferred to FlushBatch
+     * @return Whether the state could be applied, and which fields changed
      */
-    static bool SetRadioState(const std::shared_ptr<SDK>& mApiServer, const RadioState& newState,
-        const std::string& stationCallsign = "", const bool sendToElectron = true)
+    static RadioStateChange SetRadioState(const std::shared_ptr<SDK>& mApiServer,
+        const RadioState& newState, const std::string& stationCallsign = "",
+        const bool sendToElectron = true, RadioStateBatch* batch = nullptr)
     {
+        RadioStateChange change;
         if (!mClient || !mClient->IsVoiceConnected()) {
             PLOGV << "Voice is not connected, not setting radio state";
-            return false;
+            return change;
         }
 
         if (!mClient->IsFrequencyActive(newState.frequency)) {
             PLOG_VERBOSE << "Frequency is not active, not setting radio state";
-            return false;
+            return change;
         }
-
-        PLOGV << "Setting radio state for frequency=" << newState.frequency
-              << ": rx=" << newState.rx << ", tx=" << newState.tx << ", xc=" << newState.xc
-              << ", xca=" << newState.xca << ", headset = " << newState.headset;
-
-        bool oldRxValue = mClient->GetRxState(newState.frequency);
-        mClient->SetRx(newState.frequency, newState.rx);
-
-        setRadioVolume(newState.frequency, newState.outputVolume);
+        change.applied = true;
 
         bool isXy = false;
         {
             std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
             isXy = UserSession::xy;
         }
-        if (isXy) {
-            mClient->SetTx(newState.frequency, newState.tx);
-            mClient->SetXc(newState.frequency, newState.xc);
-            mClient->SetCrossCoupleAcross(newState.frequency, newState.xca);
-        } else {
-            mClient->SetTx(newState.frequency, false);
-            mClient->SetXc(newState.frequency, false);
-            mClient->SetCrossCoupleAcross(newState.frequency, false);
+
+        // Only pilots with transmit rights can have tx, xc or xca
+        const auto frequency = newState.frequency;
+        const bool tx = isXy && newState.tx;
+        const bool xc = isXy && newState.xc;
+        const bool xca = isXy && newState.xca;
+
+        const bool oldRxValue = mClient->GetRxState(frequency);
+        if (oldRxValue != newState.rx) {
+            mClient->SetRx(frequency, newState.rx);
+            change.changedFields |= RadioStateField::kRx;
         }
 
-        mClient->SetOutputMute(newState.frequency, newState.isOutputMuted);
+        // A radio without a stored volume has never had its gain applied
+        auto storedVolume = getStoredRadioVolume(frequency);
+        if (!storedVolume || *storedVolume != newState.outputVolume) {
+            setRadioVolume(frequency, newState.outputVolume);
+            change.changedFields |= RadioStateField::kOutputVolume;
+        }
 
-        mClient->SetOnHeadset(newState.frequency, newState.headset);
+        if (mClient->GetTxState(frequency) != tx) {
+            mClient->SetTx(frequency, tx);
+            change.changedFields |= RadioStateField::kTx;
+        }
+        if (mClient->GetXcState(frequency) != xc) {
+            mClient->SetXc(frequency, xc);
+            change.changedFields |= RadioStateField::kXc;
+        }
+        if (mClient->GetCrossCoupleAcrossState(frequency) != xca) {
+            mClient->SetCrossCoupleAcross(frequency, xca);
+            change.changedFields |= RadioStateField::kXca;
+        }
+        if (mClient->GetIsOutputMutedState(frequency) != newState.isOutputMuted) {
+            mClient->SetOutputMute(frequency, newState.isOutputMuted);
+            change.changedFields |= RadioStateField::kOutputMuted;
+        }
+        if (mClient->GetOnHeadset(frequency) != newState.headset) {
+            mClient->SetOnHeadset(frequency, newState.headset);
+            change.changedFields |= RadioStateField::kHeadset;
+        }
+
+        if (!change.changed()) {
+            PLOGV << "Radio state for frequency=" << frequency << " is unchanged";
+            return change;
+        }
+
+        PLOGV << "Set radio state for frequency=" << frequency << ": rx=" << newState.rx
+              << ", tx=" << tx << ", xc=" << xc << ", xca=" << xca
+              << ", headset = " << newState.headset << ", changed fields=0x" << std::hex
+              << static_cast<int>(change.changedFields) << std::dec;
 
         if (!oldRxValue && newState.rx) {
             // When turning on RX, we refresh the transceivers
             auto states = mClient->getRadioState();
-            if (states.find(newState.frequency) != states.end()
-                && !states[newState.frequency].stationName.empty()) {
-                mClient->FetchTransceiverInfo(states[newState.frequency].stationName);
+            if (states.find(frequency) != states.end()
+                && !states[frequency].stationName.empty()) {
+                if (batch != nullptr) {
+                    batch->transceiverFetches.insert(states[frequency].stationName);
+                } else {
+                    mClient->FetchTransceiverInfo(states[frequency].stationName);
+                }
             }
         }
 
-        // Included for legacy reasons in case some older client depends on this message.
-        mApiServer->handleAFVEventForWebsocket(
-            sdk::types::Event::kFrequencyStateUpdate, std::nullopt, std::nullopt);
+        NotifyStationState(mApiServer, stationCallsign, frequency,
+            change.has(RadioStateField::kRouting), sendToElectron, batch);
+        return change;
+    }
+
+    /**
+     * @brief Publishes the current state of a station, deferred to FlushBatch when batched.
+     *
+     * @param routingChanged Also send the legacy kFrequencyStateUpdate message
+     */
+    static void NotifyStationState(const std::shared_ptr<SDK>& mApiServer,
+        const std::string& stationCallsign, int frequency, bool routingChanged,
+        bool sendToElectron = true, RadioStateBatch* batch = nullptr)
+    {
+        if (batch != nullptr) {
+            batch->updatedStations.insert_or_assign(frequency, stationCallsign);
+            batch->routingChanged = batch->routingChanged || routingChanged;
+            return;
+        }
+
+        if (routingChanged) {
+            // Included for legacy reasons in case some older client depends on this message.
+            mApiServer->handleAFVEventForWebsocket(
+                sdk::types::Event::kFrequencyStateUpdate, std::nullopt, std::nullopt);
+        }
 
         // New event that only notifies of the change to this specific station.
         std::optional<std::string> optionalCallsign
             = stationCallsign.empty() ? std::nullopt : std::optional<std::string>(stationCallsign);
-        auto stateJson = mApiServer->buildStationStateJson(optionalCallsign, newState.frequency);
+        auto stateJson = mApiServer->buildStationStateJson(optionalCallsign, frequency);
         mApiServer->publishStationState(stateJson, sendToElectron);
+    }
+
+    /**
+     * @brief Issues the deferred side effects of a batch: each transceiver fetch once, one legacy
+     * frequency state update, the station states to the websocket clients and a single
+     * station-states-update event to Electron.
+     */
+    static void FlushBatch(const std::shared_ptr<SDK>& mApiServer, const RadioStateBatch& batch)
+    {
+        for (const auto& stationName : batch.transceiverFetches) {
+            mClient->FetchTransceiverInfo(stationName);
+        }
 
-        return true;
+        if (batch.updatedStations.empty()) {
+            return;
+        }
+
+        if (batch.routingChanged) {
+            mApiServer->handleAFVEventForWebsocket(
+                sdk::types::Event::kFrequencyStateUpdate, std::nullopt, std::nullopt);
+        }
+
+        auto states = nlohmann::json::array();
+        for (const auto& [frequency, stationCallsign] : batch.updatedStations) {
+            std::optional<std::string> optionalCallsign = stationCallsign.empty()
+                ? std::nullopt
+                : std::optional<std::string>(stationCallsign);
+            auto stateJson = mApiServer->buildStationStateJson(optionalCallsign, frequency);
+            mApiServer->publishStationState(stateJson, false);
+            states.push_back(std::move(stateJson));
+        }
+        NapiHelpers::callElectron("station-states-update", states);
     }
 
-    static void setAllRadioVolumes()
+    /**
+     * @brief Re-applies the gain of every radio after a main volume change.
+     *
+     * Requests are coalesced so the gains are applied at most once per audio frame, however
+     * fast the main volume slider is dragged.
+     */
+    static void setAllRadioVolumes() { gainUpdateTask.request(); }
+
+    /**
+     * @brief Stops the coalesced gain updates, must be called before mClient is destroyed.
+     */
+    static void stopGainUpdates() { gainUpdateTask.stop(); }
+
+    /**
+     * @brief Computes the gains of all radios in one pass against a single main volume, then
+     * hands them to the client.
+     */
+    static void applyAllRadioVolumes()
     {
         if (!mClient) {
             return;
         }
+
+        const float mainVolume = UserSession::currentMainVolume.load(std::memory_order_relaxed);
         auto states = mClient->getRadioState();
-        for (const auto& state : states) {
-            setRadioVolume(state.first);
+
+        std::vector<std::pair<unsigned int, float>> gains;
+        gains.reserve(states.size());
+        for (const auto& [frequency, state] : states) {
+            auto stationVolume = UserSession::stationVolumes.get(frequency).value_or(100);
+            gains.emplace_back(frequency, computeGain(mainVolume, stationVolume));
+        }
+
+        for (const auto& [frequency, gain] : gains) {
+            mClient->SetRadioGain(frequency, gain);
         }
     }
 
@@ -105,41 +259,44 @@ public:
         const unsigned int frequency, const std::optional<float> volume = std::nullopt)
     {
         float stationVolume = 100;
-        float mainVolume = 100;
 
-        {
-            std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
-            if (volume.has_value()) {
-                stationVolume = volume.value();
-                UserSession::stationVolumes.insert_or_assign(frequency, stationVolume);
-            } else {
-                auto stationVolumeIterator = UserSession::stationVolumes.find(frequency);
-                if (stationVolumeIterator != UserSession::stationVolumes.end()) {
-                    stationVolume = stationVolumeIterator->second;
-                }
-            }
-            mainVolume = UserSession::currentMainVolume;
+        if (volume.has_value()) {
+            stationVolume = volume.value();
+            UserSession::stationVolumes.set(frequency, stationVolume);
+        } else {
+            stationVolume = UserSession::stationVolumes.get(frequency).value_or(100);
         }
 
+        mClient->SetRadioGain(frequency,
+            computeGain(
+                UserSession::currentMainVolume.load(std::memory_order_relaxed), stationVolume));
+    }
+
+    static float computeGain(float mainVolume, float stationVolume)
+    {
         float combinedVolume = (mainVolume / 100.0f) * (stationVolume / 100.0f) * 100.0f;
 
         // Clamp it to ensure it stays within 0-100
         combinedVolume = std::min(100.0f, std::max(0.0f, combinedVolume));
 
         // Now convert the 0-100 volume to gain
-        float gain = Helpers::ConvertVolumeToGain(combinedVolume);
+        return Helpers::ConvertVolumeToGain(combinedVolume);
+    }
 
-        mClient->SetRadioGain(frequency, gain);
+    static std::optional<float> getStoredRadioVolume(const unsigned int frequency)
+    {
+        return UserSession::stationVolumes.get(frequency);
     }
 
     static double getRadioVolume(const unsigned int frequency)
     {
-        std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
-        auto stationVolumeIterator = UserSession::stationVolumes.find(frequency);
-        if (stationVolumeIterator != UserSession::stationVolumes.end()) {
-            return stationVolumeIterator->second;
-        }
-        return 100;
+        return getStoredRadioVolume(frequency).value_or(100);
     }
+
+private:
+    // afv-native mixes audio in 20 ms frames, applying gains more often than that is not heard
+    static constexpr auto kGainUpdateInterval = std::chrono::milliseconds(20);
+
+    inline static CoalescingTask gainUpdateTask { kGainUpdateInterval, applyAllRadioVolumes };
 };
 ;
@@ -1,11 +1,19 @@
 #pragma once
-#include <Poco/Timer.h>
-#include <absl/strings/match.h>
-#include <absl/strings/str_split.h>
+#include "Shared.hpp"
+#include <array>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <random>
 #include <string>
+#include <string_view>
+#include <thread>
 
 #define WIN32_LEAN_AND_MEAN
 #include <httplib.h>
@@ -13,29 +21,56 @@
 #include <Windows.h>
 #endif
 
-struct ConnectionInfo {
+// The network session as last reported by the slurper, notifications are only sent when it changes
+struct NetworkSession {
+    bool isConnected = false;
     std::string callsign;
-    std::string res3;
-    std::string res2;
-    std::string lat;
-    std::string lon;
-};
+    int frequency = 0;
+    bool isAtc = false;
+    // Not compared, a pilot's position changes on every poll
+    double lat = 0.0;
+    double lon = 0.0;
 
-enum class ConnectionType : std::uint8_t { z1, t0, op };
+    bool operator==(const NetworkSession& other) const
+    {
+        return isConnected == other.isConnected && callsign == other.callsign
+            && frequency == other.frequency && isAtc == other.isAtc;
+    }
+    bool operator!=(const NetworkSession& other) const { return !(*this == other); }
+};
 
 class RemoteData {
 
 public:
-    RemoteData();
+    /**
+     * @param onSessionChanged Called from the polling thread whenever the network session
+     * changed, including connecting and disconnecting
+     */
+    explicit RemoteData(std::function<void(const NetworkSession&)> onSessionChanged = nullptr);
 
     RemoteData(const RemoteData&) = delete;
     RemoteData(RemoteData&&) = delete;
     RemoteData& operator=(const RemoteData&) = delete;
     RemoteData& operator=(RemoteData&&) = delete;
-    ~RemoteData() { timer.stop(); }
+    ~RemoteData();
+
+    /**
+     * @brief Polls the slurper right away, then at a faster rate for a while. Used when the
+     * session is expected to change, e.g. after the CID was set or on connect.
+     */
+    void pollSoon();
+
+    /**
+     * @brief The session as last reported to Electron, for a window that missed the events.
+     * Not connected until the slurper was first polled.
+     */
+    NetworkSession currentSession();
 
 protected:
-    void onTimer(Poco::Timer& /*timer*/);
+    void run();
+
+    // Polls the slurper once and returns the delay until the next poll
+    std::chrono::milliseconds poll();
 
     // Returns nullopt when the slurper could not be reached, so that an outage
     // is not mistaken for the user having gone offline. A returned value is
@@ -43,43 +78,84 @@ protected:
     // connection, which is a genuine disconnect.
     std::optional<std::string> getSlurperData(const std::string& cid);
 
+    // Parses the body with SlurperParser, the session strings are only assigned when they
+    // changed
     // NOLINTNEXTLINE
-    bool parseSlurper(const std::string& sluper_data);
+    bool parseSlurper(std::string_view sluper_data);
+
+    // Called with UserSession::mtx held, returns the session to pass to notifySessionChange()
+    // once it is released
+    std::optional<NetworkSession> updateSessionStatus(
+        const std::string& previousCallsign, bool isConnected);
 
-    static void updateSessionStatus(const std::string& previousCallsign, bool isConnected);
+    // Sends the network-connected and network-disconnected events on the edges, and
+    // network-session-changed when a connected session changed. Must be called without
+    // UserSession::mtx held, as it runs onSessionChanged.
+    void notifySessionChange(const NetworkSession& session);
 
 private:
-    Poco::Timer timer;
+    // The poll interval is adapted to the session: fast right after pollSoon(), slower once the
+    // slurper data has been unchanged for a while, and backing off exponentially with jitter
+    // while the slurper is unreachable
+    static constexpr auto kInitialPollDelay = std::chrono::seconds(3);
+    static constexpr auto kFastPollInterval = std::chrono::seconds(5);
+    static constexpr auto kFastPollWindow = std::chrono::seconds(60);
+    static constexpr auto kPollInterval = std::chrono::seconds(TIMER_CALLBACK_INTERVAL_SEC);
+    static constexpr auto kStablePollInterval = std::chrono::seconds(30);
+    static constexpr int kPollsUntilStable = 4;
+    static constexpr auto kMaxBackoffInterval = std::chrono::seconds(120);
+
+    std::chrono::milliseconds nextPollDelay(bool unchanged);
+    std::chrono::milliseconds nextBackoffDelay();
+
+    std::mutex m;
+    std::condition_variable cv;
+    bool pollRequested = false;
+    bool stopRequested = false;
+    std::chrono::steady_clock::time_point fastPollUntil;
+    // Copy of lastSession readable from other threads
+    NetworkSession reportedSession;
+    std::thread worker;
+
+    std::function<void(const NetworkSession&)> onSessionChanged;
+
+    // Only used from the worker thread
+    std::optional<NetworkSession> lastSession;
+    int unchangedPolls = 0;
+    int failedPolls = 0;
+    std::mt19937 backoffJitter { std::random_device {}() };
+
+    // Validators of the last successful response, sent back as a conditional request so an
+    // unchanged session costs a 304 without a body
+    struct SlurperResponseCache {
+        std::string cid;
+        std::string etag;
+        std::string lastModified;
+        std::string body;
+    };
+    SlurperResponseCache slurperCache;
+
+    // Kept open between polls so the TCP connection and TLS session are reused, dropped after a
+    // failed request so the next poll reconnects from scratch. Guarded by m so the destructor can
+    // cancel a request in flight.
+    std::shared_ptr<httplib::Client> slurperClient;
+    std::string slurperClientBaseUrl;
+
+    // nullptr once stopping
+    std::shared_ptr<httplib::Client> getSlurperClient();
+    void resetSlurperClient();
+    bool isStopping();
+    void recordSlurperPoll(std::chrono::steady_clock::duration duration, bool reusedConnection);
+
+    static constexpr size_t kPollStatsWindow = 20;
+    uint64_t slurperPolls = 0;
+    uint64_t slurperConnectionReuses = 0;
+    std::deque<int64_t> recentPollDurationsMs;
 
-    bool pYx = false;
     bool userHasBeenNotifiedOfSlurperUnavailability = false;
     bool enteredSlurperGracePeriod = false;
-    std::mutex m;
 
     void notifyUserOfSlurperAvailability() const;
 
     void notifyUserOfSlurperUnavalability();
-
-    // NOLINTNEXTLINE
-    static inline const std::vector<std::string> kk_882_ex = { "_CTR", "_APP", "_TWR", "_GND",
-        "_DEP", "_DEL", "_FSS", "_SUP", "_RDO", "_RMP", "_TMU", "_FMP" };
-
-    static ConnectionType getPyx_00z(bool x, const std::string& y)
-    {
-        bool pyx = false;
-        for (const auto& d_3_ : kk_882_ex) {
-            if (absl::EndsWith(y, d_3_)) {
-                pyx = true;
-                break;
-            }
-        }
-
-        if (pyx) {
-            return ConnectionType::z1;
-        } else if (x) {
-            return ConnectionType::t0;
-        } else {
-            return ConnectionType::op;
-        }
-    }
 };
@@ -1,6 +1,8 @@
 #pragma once
+#include "ChannelIndex.hpp"
 #include "afv-native/atcClientWrapper.h"
 #include <SimpleIni.h>
+#include <atomic>
 #include <filesystem>
 #include <memory>
 #include <mutex>
@@ -10,6 +12,13 @@
 #include <semver.hpp>
 #include <string>
 
+#ifdef TRACKAUDIO_FAKE_AFV
+#include "FakeAtcClient.hpp"
+using AtcClient = FakeAtcClient;
+#else
+using AtcClient = afv_native::api::atcClient;
+#endif
+
 // Constants
 #define TIMER_CALLBACK_INTERVAL_SEC 15
 #define SLURPER_BASE_URL "https://slurper.vatsim.net"
@@ -24,7 +33,7 @@
 
 extern const semver::version VERSION;
 extern const std::string CLIENT_NAME;
-extern std::unique_ptr<afv_native::api::atcClient> mClient;
+extern std::unique_ptr<AtcClient> mClient;
 
 struct FileSystem {
     static std::filesystem::path GetStateFolderPath();
@@ -49,9 +58,11 @@ public:
     static double lon;
     static bool xy;
     static bool isConnectedToTheNetwork;
-    static float currentMainVolume;
+    // Not guarded by mtx
+    static std::atomic<float> currentMainVolume;
     static bool isDebug;
-    static std::map<unsigned int, float> stationVolumes;
+    // Not guarded by mtx, the table is safe to use from any thread
+    static ChannelVolumeTable stationVolumes;
     static std::mutex mtx;
 };
 
@@ -60,6 +71,18 @@ public:
     static bool isSlurperAvailable;
 };
 
+struct RemoteEndpoints {
+public:
+    // Base URLs of the slurper and the version check, SLURPER_BASE_URL and VERSION_CHECK_BASE_URL
+    // unless overridden at runtime, e.g. to point them at a local SlurperStandIn
+    static std::string slurperBaseUrl;
+    static std::string versionCheckBaseUrl;
+    static std::mutex mtx;
+
+    static std::string getSlurperBaseUrl();
+    static std::string getVersionCheckBaseUrl();
+};
+
 struct UserSettings {
 public:
     static int configVersion;
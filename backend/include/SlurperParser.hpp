@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+// Fields of a slurper line, viewing into the response body
+struct ConnectionInfo {
+    std::string_view callsign;
+    std::string_view res3;
+    std::string_view res2;
+    std::string_view lat;
+    std::string_view lon;
+};
+
+enum class ConnectionType : std::uint8_t { z1, t0, op };
+
+// The connection picked from a slurper response, the callsign views into the response body
+struct SlurperConnection {
+    std::string_view callsign;
+    // The frequency as listed, in Hz and not cleaned up yet
+    int frequency = 0;
+    bool isAtc = false;
+    double lat = 0.0;
+    double lon = 0.0;
+};
+
+/**
+ * @brief Parses slurper responses in a single pass without allocating.
+ *
+ * Kept free of the rest of the backend so the fuzz target and the benchmark build on their own.
+ */
+class SlurperParser {
+public:
+    /**
+     * @brief Picks the first ATC connection of the response, otherwise its first connection that
+     * is not a pilot.
+     *
+     * @return nullopt when the response has no such connection.
+     * @throws std::invalid_argument when the picked connection has an unreadable coordinate.
+     */
+    static std::optional<SlurperConnection> parse(std::string_view data);
+
+private:
+    // NOLINTNEXTLINE
+    static constexpr std::array<std::string_view, 12> kk_882_ex = { "_CTR", "_APP", "_TWR",
+        "_GND", "_DEP", "_DEL", "_FSS", "_SUP", "_RDO", "_RMP", "_TMU", "_FMP" };
+
+    static bool endsWith(std::string_view text, std::string_view suffix)
+    {
+        return text.size() >= suffix.size()
+            && text.substr(text.size() - suffix.size()) == suffix;
+    }
+
+    static ConnectionType getPyx_00z(bool x, std::string_view y)
+    {
+        bool pyx = false;
+        for (const auto& d_3_ : kk_882_ex) {
+            if (endsWith(y, d_3_)) {
+                pyx = true;
+                break;
+            }
+        }
+
+        if (pyx) {
+            return ConnectionType::z1;
+        } else if (x) {
+            return ConnectionType::t0;
+        } else {
+            return ConnectionType::op;
+        }
+    }
+};
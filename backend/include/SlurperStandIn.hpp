@@ -0,0 +1,123 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace httplib {
+class Server;
+struct Request;
+struct Response;
+}
+
+enum class SlurperStandInStepType : std::uint8_t {
+    kBody,
+    kStatus,
+    kDelay,
+    kVersion,
+};
+
+/**
+ * @brief A change of the stand-in's responses on a scripted timeline.
+ *
+ * Body sets a 200 response with the given slurper data, Status replaces the status code until
+ * the next Body, Delay holds every later response back and Version sets the mandatory version.
+ */
+struct SlurperStandInStep {
+    std::chrono::milliseconds offset { 0 };
+    SlurperStandInStepType type = SlurperStandInStepType::kBody;
+    std::string text;
+    int status = 200;
+    std::chrono::milliseconds delay { 0 };
+};
+
+struct SlurperStandInRequest {
+    std::chrono::milliseconds offset { 0 };
+    std::string path;
+    int status = 0;
+};
+
+/**
+ * @brief Local HTTP server standing in for the slurper and the version check endpoint.
+ *
+ * Serves scripted responses so the RemoteData session logic can be driven offline, once
+ * RemoteEndpoints points at it. A script is a text file with one step per line,
+ * `<offsetMs> <Step> [argument]`, each step applying from its offset on, for example:
+ *
+ *   0     Version 1.0.0
+ *   0     Body 1234567,EDDF_TWR,EDDF_TWR,119.900,0,50.0333,8.5706
+ *   30000 Body 1234567,EDDF_N_TWR,EDDF_N_TWR,119.900,0,50.0333,8.5706
+ *   60000 Status 503
+ *   90000 Delay 15000
+ *   120000 Body
+ *
+ * Body without an argument serves an empty body, i.e. the CID has no connection, and "\n" in a
+ * body separates lines. A Delay longer than the client's read timeout simulates an unreachable
+ * server. Responses carry an ETag so conditional requests can be answered with a 304. Every
+ * request is logged with its offset so reaction times can be measured.
+ */
+class SlurperStandIn {
+public:
+    SlurperStandIn();
+    ~SlurperStandIn();
+
+    SlurperStandIn(const SlurperStandIn&) = delete;
+    SlurperStandIn(SlurperStandIn&&) = delete;
+    SlurperStandIn& operator=(const SlurperStandIn&) = delete;
+    SlurperStandIn& operator=(SlurperStandIn&&) = delete;
+
+    /**
+     * @brief Parses a timeline script.
+     *
+     * @param script The script contents.
+     * @return The steps sorted by offset.
+     * @throws std::invalid_argument on malformed lines.
+     */
+    static std::vector<SlurperStandInStep> parseScript(const std::string& script);
+    static std::vector<SlurperStandInStep> loadScript(const std::filesystem::path& path);
+
+    /**
+     * @brief Starts serving a timeline on a free port of the loopback interface, replacing any
+     * timeline already served.
+     *
+     * @return The base URL of the server, e.g. http://127.0.0.1:51234
+     * @throws std::runtime_error when no port could be bound.
+     */
+    std::string start(std::vector<SlurperStandInStep> timeline);
+    void stop();
+
+    [[nodiscard]] std::vector<SlurperStandInRequest> requests() const;
+
+private:
+    struct ResponseState {
+        int status = 200;
+        std::string body;
+        std::chrono::milliseconds delay { 0 };
+        std::optional<std::string> version;
+    };
+
+    void handleSlurper(const httplib::Request& req, httplib::Response& res);
+    void handleVersion(const httplib::Request& req, httplib::Response& res);
+
+    ResponseState stateAt(std::chrono::milliseconds offset) const;
+    std::chrono::milliseconds elapsed() const;
+    // Returns false when stopped while waiting
+    bool waitFor(std::chrono::milliseconds delay);
+    void logRequest(std::chrono::milliseconds offset, const std::string& path, int status);
+
+    std::unique_ptr<httplib::Server> server;
+    std::thread worker;
+
+    mutable std::mutex m;
+    std::condition_variable cv;
+    bool stopRequested = false;
+    std::vector<SlurperStandInStep> timeline;
+    std::chrono::steady_clock::time_point startTime;
+    std::vector<SlurperStandInRequest> requestLog;
+};
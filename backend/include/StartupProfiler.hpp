@@ -0,0 +1,71 @@
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+struct StartupPhaseTiming {
+    std::string name;
+    // Relative to the module being loaded
+    double startMs = 0;
+    double wallMs = 0;
+    // Process CPU time over the phase, including any thread it started
+    double cpuMs = 0;
+};
+
+/**
+ * @brief Records wall-clock and CPU time of the startup phases in Init and Bootstrap.
+ *
+ * finish() writes the report to startup_report.json in the state folder, along with the
+ * reports of previous runs so that startup regressions can be compared between releases.
+ */
+class StartupProfiler {
+public:
+    /**
+     * @brief Times the enclosing scope as one startup phase.
+     */
+    class Phase {
+    public:
+        explicit Phase(std::string name);
+        Phase(const Phase&) = delete;
+        Phase(Phase&&) = delete;
+        Phase& operator=(const Phase&) = delete;
+        Phase& operator=(Phase&&) = delete;
+        ~Phase();
+
+    private:
+        std::string name;
+        std::chrono::steady_clock::time_point wallStart;
+        double cpuStartMs;
+    };
+
+    static void record(StartupPhaseTiming&& timing);
+
+    /**
+     * @brief Ends the startup profile and persists it, later phases are not recorded.
+     */
+    static void finish();
+
+    /**
+     * @brief The report of this run and the history of previous ones.
+     */
+    static nlohmann::json report();
+
+    static double processCpuMs();
+    static double msSinceLoad(std::chrono::steady_clock::time_point timePoint);
+
+private:
+    static nlohmann::json currentReport();
+    static std::string reportPath();
+
+    static constexpr size_t kMaxHistory = 20;
+
+    inline static const std::chrono::steady_clock::time_point loadTime
+        = std::chrono::steady_clock::now();
+
+    inline static std::mutex m;
+    inline static std::vector<StartupPhaseTiming> phases;
+    inline static bool finished = false;
+    inline static nlohmann::json history = nlohmann::json::array();
+};
@@ -0,0 +1,183 @@
+#pragma once
+#include "AfvEventInjector.hpp"
+#include "BoundedMpmcQueue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Trace file layout, all integers in host byte order:
+//   header: char magic[8] = "TATRACE\0", uint32 version, uint32 reserved,
+//           uint64 wall clock start in milliseconds since the epoch
+//   record: uint64 nanoseconds since start, uint8 kind, uint8 code, uint16 payload length,
+//           payload bytes
+// Payload strings are encoded as a uint16 length followed by the bytes.
+namespace trace {
+inline constexpr std::array<char, 8> kMagic = { 'T', 'A', 'T', 'R', 'A', 'C', 'E', '\0' };
+inline constexpr uint32_t kVersion = 1;
+inline constexpr size_t kFileHeaderSize = 24;
+inline constexpr size_t kRecordHeaderSize = 12;
+inline constexpr size_t kMaxPayloadSize = 496;
+
+enum class RecordKind : std::uint8_t {
+    // An AFV event that can be replayed, code is the AfvScriptedEventType
+    kAfvEvent,
+    // An AFV event kept for reference only, payload is its name and a detail string
+    kAfvNotice,
+    // An N-API call, payload is the function name and its stringified arguments
+    kNapiCall,
+    // An SDK websocket message, payload is the raw JSON
+    kSdkCommand,
+};
+
+struct Record {
+    uint64_t timestampNs = 0;
+    RecordKind kind = RecordKind::kAfvEvent;
+    uint8_t code = 0;
+    uint16_t length = 0;
+    std::array<char, kMaxPayloadSize> payload {};
+};
+
+/**
+ * @brief Appends length-prefixed fields to a record payload, truncating what does not fit.
+ */
+class PayloadWriter {
+public:
+    explicit PayloadWriter(Record& record)
+        : record(record)
+    {
+    }
+
+    void writeU32(uint32_t value) { writeBytes(&value, sizeof(value)); }
+
+    void writeString(std::string_view value)
+    {
+        if (record.length + sizeof(uint16_t) > kMaxPayloadSize) {
+            return;
+        }
+        auto length = static_cast<uint16_t>(
+            std::min<size_t>(value.size(), kMaxPayloadSize - record.length - sizeof(uint16_t)));
+        writeBytes(&length, sizeof(length));
+        writeBytes(value.data(), length);
+    }
+
+private:
+    void writeBytes(const void* data, size_t size)
+    {
+        if (record.length + size > kMaxPayloadSize) {
+            return;
+        }
+        std::memcpy(record.payload.data() + record.length, data, size);
+        record.length = static_cast<uint16_t>(record.length + size);
+    }
+
+    Record& record;
+};
+
+/**
+ * @brief Reads fields written by PayloadWriter, yielding empty values past the end.
+ */
+class PayloadReader {
+public:
+    explicit PayloadReader(std::string_view payload)
+        : payload(payload)
+    {
+    }
+
+    uint32_t readU32()
+    {
+        uint32_t value = 0;
+        if (payload.size() >= sizeof(value)) {
+            std::memcpy(&value, payload.data(), sizeof(value));
+            payload.remove_prefix(sizeof(value));
+        }
+        return value;
+    }
+
+    std::string_view readString()
+    {
+        uint16_t length = 0;
+        if (payload.size() < sizeof(length)) {
+            return {};
+        }
+        std::memcpy(&length, payload.data(), sizeof(length));
+        payload.remove_prefix(sizeof(length));
+        auto value = payload.substr(0, length);
+        payload.remove_prefix(value.size());
+        return value;
+    }
+
+private:
+    std::string_view payload;
+};
+} // namespace trace
+
+/**
+ * @brief Optional recorder of AFV events, N-API calls and SDK commands into a binary trace.
+ *
+ * Producers on any thread format a fixed-size record and push it to a lock-free ring buffer,
+ * a background thread appends the records to the trace file. When nothing is recording, every
+ * record call is a single atomic load.
+ */
+class TraceRecorder {
+public:
+    /**
+     * @brief Starts recording into a new trace file, stopping any previous recording.
+     *
+     * @param path The trace file to create.
+     * @return false if the file could not be created.
+     */
+    static bool start(const std::filesystem::path& path);
+    static void stop();
+
+    static bool isRecording() { return recording.load(std::memory_order_acquire); }
+
+    static void recordAfvEvent(AfvScriptedEventType type, unsigned int frequency = 0,
+        std::string_view callsign = {}, const std::vector<std::string>& activeTransmitters = {},
+        std::string_view name = {});
+    static void recordAfvNotice(std::string_view eventName, std::string_view detail = {});
+    static void recordCommand(
+        trace::RecordKind kind, std::string_view name, std::string_view arguments = {});
+
+    /**
+     * @return The number of records lost because the ring buffer was full.
+     */
+    static uint64_t droppedRecords() { return dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @return A default trace file path in the state folder, named after the current time.
+     */
+    static std::filesystem::path defaultTracePath();
+
+private:
+    static void push(trace::Record&& record);
+    static void writerLoop(std::ofstream* file);
+    static uint64_t elapsedNs();
+
+    static constexpr size_t kRingCapacity = 2048;
+    static constexpr std::chrono::milliseconds kWriterInterval { 20 };
+
+    inline static std::atomic<bool> recording = false;
+    inline static std::atomic<uint64_t> dropped = 0;
+    inline static std::atomic<int64_t> startTimeNs = 0;
+    inline static std::unique_ptr<BoundedMpmcQueue<trace::Record>> ring = nullptr;
+
+    inline static std::mutex lifecycleMutex;
+    inline static std::mutex writerMutex;
+    inline static std::condition_variable writerCv;
+    inline static bool writerStopRequested = false;
+    inline static std::unique_ptr<std::ofstream> traceFile = nullptr;
+    inline static std::unique_ptr<std::thread> writerThread = nullptr;
+};
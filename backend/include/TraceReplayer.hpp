@@ -0,0 +1,88 @@
+#pragma once
+#include "TraceRecorder.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ */
+class MappedFile {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    [[nodiscard]] std::string_view data() const
+    {
+        return { static_cast<const char*>(address), size };
+    }
+
+private:
+    void* address = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+/**
+ * @brief Replays a trace written by TraceRecorder into the running backend.
+ *
+ * The trace is memory-mapped and walked in place. AFV events are published on the EventBus,
+ * SDK commands are handed to the SDK command sink, N-API calls and AFV notices are only logged
+ * since they cannot be reissued from the native side.
+ */
+class TraceReplayer {
+public:
+    using SdkCommandSink = std::function<void(std::string_view payload)>;
+
+    explicit TraceReplayer(SdkCommandSink sdkCommandSink);
+    ~TraceReplayer();
+
+    TraceReplayer(const TraceReplayer&) = delete;
+    TraceReplayer(TraceReplayer&&) = delete;
+    TraceReplayer& operator=(const TraceReplayer&) = delete;
+    TraceReplayer& operator=(TraceReplayer&&) = delete;
+
+    /**
+     * @brief Starts replaying a trace on a background thread, replacing any running replay.
+     *
+     * @param path The trace file.
+     * @param speed Playback speed multiplier, 1.0 is real time. 0 replays without waiting.
+     * @throws std::runtime_error if the file is not a valid trace.
+     */
+    void start(const std::filesystem::path& path, double speed = 1.0);
+    void stop();
+    [[nodiscard]] bool isRunning() const { return running.load(); }
+
+    /**
+     * @brief Decodes a kAfvEvent record payload.
+     */
+    static AfvScriptedEvent decodeAfvEvent(uint8_t code, std::string_view payload);
+
+private:
+    void run(std::shared_ptr<MappedFile> file, double speed);
+
+    SdkCommandSink sdkCommandSink;
+    std::thread worker;
+    std::mutex m;
+    std::condition_variable cv;
+    bool stopRequested = false;
+    std::atomic<bool> running { false };
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <plog/Log.h>
@@ -23,6 +24,21 @@ public:
     using EventCallback = std::function<void(const uiohook_event*)>;
     void setEventCallback(EventCallback callback);
 
+    // One bit per uiohook event_type
+    using EventMask = uint32_t;
+    static constexpr EventMask eventMaskOf(event_type type) { return 1U << type; }
+    static constexpr EventMask kAllEvents = ~EventMask { 0 };
+    static constexpr EventMask kKeyEvents = (1U << EVENT_KEY_PRESSED) | (1U << EVENT_KEY_RELEASED);
+
+    /**
+     * @brief Sets the event types forwarded to the callback, all by default.
+     *
+     * Other events are dropped in the dispatch proc before reaching the callback, which matters
+     * for mouse moves that come in by the thousands per second. libuiohook still hooks the mouse
+     * though, it has no way to hook the keyboard only.
+     */
+    void setEventMask(EventMask mask);
+
     bool isRunning() const;
 
 private:
@@ -39,4 +55,9 @@ public:
     EventCallback eventCallback;
     std::thread hookThread;
     std::atomic<bool> running { false };
+    std::atomic<UIOHookWrapper::EventMask> eventMask { UIOHookWrapper::kAllEvents };
+
+    // Only written from the hook thread, logged when stopping
+    std::atomic<uint64_t> forwardedEvents { 0 };
+    std::atomic<uint64_t> droppedEvents { 0 };
 };
@@ -0,0 +1,78 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <semver.hpp>
+#include <string>
+#include <thread>
+
+namespace httplib {
+class Client;
+}
+
+enum class VersionCheckState : std::uint8_t { kPending, kUpToDate, kUpdateRequired, kFailed };
+
+struct VersionCheckResult {
+    VersionCheckState state = VersionCheckState::kPending;
+    std::string mandatoryVersion;
+    // The result comes from the cached mandatory version rather than a fresh fetch
+    bool fromCache = false;
+};
+
+/**
+ * @brief Fetches the mandatory version in the background.
+ *
+ * The last fetched mandatory version is cached in the state folder. A cached version newer
+ * than ours is known at construction without any network access. If the fetch fails, the cache
+ * is used in its place. Only Connect waits for the result, so a slow or unreachable server does
+ * not hold up startup.
+ */
+class VersionChecker {
+public:
+    VersionChecker();
+    VersionChecker(const VersionChecker&) = delete;
+    VersionChecker(VersionChecker&&) = delete;
+    VersionChecker& operator=(const VersionChecker&) = delete;
+    VersionChecker& operator=(VersionChecker&&) = delete;
+    ~VersionChecker();
+
+    /**
+     * @brief Starts the fetch, unless one is running or already succeeded.
+     */
+    void start();
+
+    /**
+     * @brief Aborts a running fetch and wakes up anyone waiting for the result.
+     */
+    void stop();
+
+    VersionCheckResult result();
+
+    /**
+     * @brief Waits up to timeout for the result, restarting the fetch first if it had failed.
+     */
+    VersionCheckResult awaitResult(std::chrono::milliseconds timeout);
+
+private:
+    void run();
+    void finish(VersionCheckResult&& newResult);
+
+    static std::filesystem::path cachePath();
+    static std::optional<std::string> readCache();
+    static void writeCache(const std::string& mandatoryVersion);
+    static VersionCheckResult compare(const std::string& mandatoryVersion, bool fromCache);
+
+    std::optional<std::string> cachedVersion;
+
+    std::mutex m;
+    std::condition_variable cv;
+    VersionCheckResult currentResult;
+    bool running = false;
+    bool stopRequested = false;
+    std::shared_ptr<httplib::Client> activeClient;
+    std::thread worker;
+};
@@ -67,7 +67,7 @@ private:
 
     // Private methods
     void sendMessage(uint64_t clientId, const std::string& data);
-    void broadcastMessage(const std::string& data, MessageScope scope,
+    void broadcastMessage(const nlohmann::json& data, MessageScope scope,
         const std::optional<std::string>& electronEventName = std::nullopt);
     void buildServer();
     std::unique_ptr<restinio::router::express_router_t<>> buildRouter();
@@ -86,6 +86,7 @@ private:
     void handleGetStationStates(uint64_t requesterId);
     void handleGetStationState(const std::string& callsign, uint64_t requesterId);
     void handleGetMainVolume(uint64_t requesterId);
+    void handleGetPttLatency(uint64_t requesterId);
     void handleAddStation(const nlohmann::json& json, uint64_t clientId);
     void handleChangeStationVolume(const nlohmann::json& json, uint64_t clientId);
     void handleChangeMainVolume(const nlohmann::json& json, uint64_t clientId);
@@ -122,4 +123,11 @@ public:
     void publishStationAdded(const std::string& callsign, const int& frequencyHz,
         const std::optional<int>& frequencyAlias = std::nullopt);
     void publishFrequencyRemoved(const int& frequencyHz);
+    void publishNetworkSession(
+        bool isConnected, const std::string& callsign, const int& frequencyHz, bool isAtc);
+
+    /**
+     * @brief Handles a websocket message recorded in a trace as if a client had sent it.
+     */
+    void replayWebSocketRequest(const std::string& payload);
 };
@@ -20,6 +20,8 @@ enum class WebsocketMessageType : std::uint8_t {
     kStationAdded,
     kAddStation,
     kMainVolumeChange,
+    kNetworkSessionUpdate,
+    kPttLatencyReport,
 };
 
 inline const std::map<WebsocketMessageType, std::string>& getWebsocketMessageTypeMap()
@@ -37,6 +39,8 @@ inline const std::map<WebsocketMessageType, std::string>& getWebsocketMessageTyp
         { WebsocketMessageType::kStationAdded, "kStationAdded" },
         { WebsocketMessageType::kAddStation, "kAddStation" },
         { WebsocketMessageType::kMainVolumeChange, "kMainVolumeChange" },
+        { WebsocketMessageType::kNetworkSessionUpdate, "kNetworkSessionUpdate" },
+        { WebsocketMessageType::kPttLatencyReport, "kPttLatencyReport" },
     };
     return kWebsocketMessageTypeMap;
 }
@@ -125,3 +129,13 @@ protected:
 // Example of kTxEnd message:
 // @type the type of the message
 // JSON: {"type": "kTxEnd", "value": {}}
+
+// Example of kPttLatencyReport message, sent in reply to kGetPttLatency:
+// @type the type of the message
+// @value latency histograms of the PTT press stages, each stage measured from the previous one,
+// and endToEnd from the input event to the AFV PttOpenEvent
+// JSON: {"type": "kPttLatencyReport", "value": {"stages": {"decision": {"count": 12, "meanUs":
+// 85.2, "p50Us": 100, "p95Us": 250, "p99Us": 250, "maxUs": 212.4, "buckets": [{"count": 9,
+// "maxUs": 100}, {"count": 3, "maxUs": 250}]}, "setPtt": {...}, "afvPttOpen": {...},
+// "sdkTxBegin": {...}}, "endToEnd": {...}, "sources": {"keyboard": 12, "joystickEvdev": 0,
+// "joystickPoll": 0}}}
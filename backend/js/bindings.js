@@ -5,19 +5,22 @@ exports.AfvEventTypes = {
   VoiceDisconnected: "VoiceDisconnected",
   StationTransceiversUpdated: "StationTransceiversUpdated",
   StationDataReceived: "StationDataReceived",
+  StationsDataReceived: "StationsDataReceived",
   FrequencyRxBegin: "FrequencyRxBegin",
   FrequencyRxEnd: "FrequencyRxEnd",
   StationRxBegin: "StationRxBegin",
   StationRxEnd: "StationRxEnd",
   PttState: "PttState",
-  VuMeter: "VuMeter",
   NetworkConnected: "network-connected",
   NetworkDisconnected: "network-disconnected",
+  NetworkSessionChanged: "network-session-changed",
   PttKeySet: "UpdatePttKeyName",
   StationStateUpdate: "station-state-update",
+  StationStatesUpdate: "station-states-update",
   OpenSettingsModal: "open-settings-modal",
   MainVolumeChange: "main-volume-change",
   AudioDeviceStopped: "AudioDeviceStopped",
+  AudioDevicesChanged: "AudioDevicesChanged",
   VoiceConnectionDegraded: "VoiceConnectionDegraded",
   VoiceConnectionResumed: "VoiceConnectionResumed",
 };
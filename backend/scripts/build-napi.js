@@ -8,6 +8,8 @@ process.chdir(TA_PATH);
 const args = process.argv.slice(2);
 const isDebug = args.includes("--debug");
 const isFast = args.includes("--fast");
+// Builds the in-memory fake AFV client and the synthetic traffic sources, for tests and benches
+const isFakeAfv = args.includes("--fake-afv");
 const isWindows = /^win/.test(process.platform);
 
 const oldBuildPath = path.join(TA_PATH, "build", isDebug ? "Release" : "Debug");
@@ -38,6 +40,10 @@ async function build() {
       cmakeJsCommand.push('-D');
     }
 
+    if (isFakeAfv) {
+      cmakeJsCommand.push('--CDTRACKAUDIO_FAKE_AFV=ON');
+    }
+
     cmakeJsCommand.push('--parallel', isFast ? '8' : '2');
 
     console.log(`Running command: ${cmakeJsCommand.join(' ')}`);
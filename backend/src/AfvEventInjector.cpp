@@ -0,0 +1,255 @@
+#include "AfvEventInjector.hpp"
+#include "afv-native/atcClientWrapper.h"
+#include "afv-native/event.h"
+#include "afv-native/event/EventBus.h"
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_split.h>
+#include <absl/strings/strip.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <plog/Log.h>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+const std::map<std::string, AfvScriptedEventType>& getScriptedEventNameMap()
+{
+    static const std::map<std::string, AfvScriptedEventType> kScriptedEventNameMap {
+        { "VoiceServerConnected", AfvScriptedEventType::kVoiceServerConnected },
+        { "VoiceServerDisconnected", AfvScriptedEventType::kVoiceServerDisconnected },
+        { "VoiceServerConnectionDegraded", AfvScriptedEventType::kVoiceServerConnectionDegraded },
+        { "VoiceServerConnectionResumed", AfvScriptedEventType::kVoiceServerConnectionResumed },
+        { "FrequencyRxBegin", AfvScriptedEventType::kFrequencyRxBegin },
+        { "FrequencyRxEnd", AfvScriptedEventType::kFrequencyRxEnd },
+        { "StationRxBegin", AfvScriptedEventType::kStationRxBegin },
+        { "StationRxEnd", AfvScriptedEventType::kStationRxEnd },
+        { "PttOpen", AfvScriptedEventType::kPttOpen },
+        { "PttClosed", AfvScriptedEventType::kPttClosed },
+        { "StationTransceiversUpdated", AfvScriptedEventType::kStationTransceiversUpdated },
+        { "AudioDeviceStoppedError", AfvScriptedEventType::kAudioDeviceStoppedError },
+    };
+    return kScriptedEventNameMap;
+}
+
+unsigned int parseFrequency(absl::string_view value, size_t lineNumber)
+{
+    unsigned int frequency = 0;
+    if (!absl::SimpleAtoi(value, &frequency)) {
+        throw std::invalid_argument(
+            "Invalid frequency on line " + std::to_string(lineNumber) + ": " + std::string(value));
+    }
+    return frequency;
+}
+}
+
+AfvEventInjector::~AfvEventInjector() { stop(); }
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+std::vector<AfvScriptedEvent> AfvEventInjector::parseScript(const std::string& script)
+{
+    std::vector<AfvScriptedEvent> timeline;
+    size_t lineNumber = 0;
+
+    for (absl::string_view line : absl::StrSplit(script, '\n')) {
+        lineNumber++;
+        line = absl::StripAsciiWhitespace(line);
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        std::vector<absl::string_view> tokens = absl::StrSplit(line, ' ', absl::SkipWhitespace());
+        if (tokens.size() < 2) {
+            throw std::invalid_argument("Missing event name on line " + std::to_string(lineNumber));
+        }
+
+        int64_t offsetMs = 0;
+        if (!absl::SimpleAtoi(tokens[0], &offsetMs) || offsetMs < 0) {
+            throw std::invalid_argument("Invalid offset on line " + std::to_string(lineNumber));
+        }
+
+        auto typeIt = getScriptedEventNameMap().find(std::string(tokens[1]));
+        if (typeIt == getScriptedEventNameMap().end()) {
+            throw std::invalid_argument("Unknown event on line " + std::to_string(lineNumber) + ": "
+                + std::string(tokens[1]));
+        }
+
+        AfvScriptedEvent event;
+        event.offset = std::chrono::milliseconds(offsetMs);
+        event.type = typeIt->second;
+
+        switch (event.type) {
+        case AfvScriptedEventType::kFrequencyRxBegin:
+        case AfvScriptedEventType::kFrequencyRxEnd:
+            if (tokens.size() < 3) {
+                throw std::invalid_argument(
+                    "Missing frequency on line " + std::to_string(lineNumber));
+            }
+            event.frequency = parseFrequency(tokens[2], lineNumber);
+            break;
+        case AfvScriptedEventType::kStationRxBegin:
+        case AfvScriptedEventType::kStationRxEnd:
+            if (tokens.size() < 4) {
+                throw std::invalid_argument(
+                    "Missing frequency or callsign on line " + std::to_string(lineNumber));
+            }
+            event.frequency = parseFrequency(tokens[2], lineNumber);
+            event.callsign = std::string(tokens[3]);
+            if (tokens.size() > 4) {
+                event.activeTransmitters = absl::StrSplit(tokens[4], ',', absl::SkipEmpty());
+            }
+            break;
+        case AfvScriptedEventType::kStationTransceiversUpdated:
+        case AfvScriptedEventType::kAudioDeviceStoppedError:
+            if (tokens.size() < 3) {
+                throw std::invalid_argument("Missing name on line " + std::to_string(lineNumber));
+            }
+            event.name = std::string(tokens[2]);
+            break;
+        default:
+            break;
+        }
+
+        timeline.push_back(std::move(event));
+    }
+
+    std::stable_sort(timeline.begin(), timeline.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.offset < rhs.offset; });
+    return timeline;
+}
+
+std::vector<AfvScriptedEvent> AfvEventInjector::loadScript(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    if (!file) {
+        throw std::invalid_argument("Cannot open event script " + path.string());
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parseScript(buffer.str());
+}
+
+void AfvEventInjector::start(std::vector<AfvScriptedEvent> timeline, double speed, int repeat)
+{
+    stop();
+
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopRequested = false;
+    }
+    running = true;
+    worker = std::thread(&AfvEventInjector::run, this, std::move(timeline), speed, repeat);
+}
+
+void AfvEventInjector::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopRequested = true;
+    }
+    cv.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+    running = false;
+}
+
+void AfvEventInjector::run(std::vector<AfvScriptedEvent> timeline, double speed, int repeat)
+{
+    PLOGI << "Playing scripted AFV timeline: " << timeline.size() << " events, speed " << speed
+          << ", repeat " << repeat;
+
+    for (int i = 0; i < repeat; i++) {
+        auto startTime = std::chrono::steady_clock::now();
+        for (const auto& event : timeline) {
+            if (speed > 0) {
+                auto due = startTime
+                    + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        event.offset / speed);
+                std::unique_lock<std::mutex> lock(m);
+                if (cv.wait_until(lock, due, [this] { return stopRequested; })) {
+                    running = false;
+                    return;
+                }
+            } else {
+                std::lock_guard<std::mutex> lock(m);
+                if (stopRequested) {
+                    running = false;
+                    return;
+                }
+            }
+
+            fire(event);
+        }
+    }
+
+    PLOGI << "Scripted AFV timeline finished";
+    running = false;
+}
+
+void AfvEventInjector::fire(const AfvScriptedEvent& event)
+{
+    auto& eventBus = afv_native::api::getEventBus();
+
+    switch (event.type) {
+    case AfvScriptedEventType::kVoiceServerConnected:
+        eventBus.PostEvent(afv_native::VoiceServerConnectedEvent {});
+        break;
+    case AfvScriptedEventType::kVoiceServerDisconnected:
+        eventBus.PostEvent(afv_native::VoiceServerDisconnectedEvent {});
+        break;
+    case AfvScriptedEventType::kVoiceServerConnectionDegraded:
+        eventBus.PostEvent(afv_native::VoiceServerConnectionDegradedEvent {});
+        break;
+    case AfvScriptedEventType::kVoiceServerConnectionResumed:
+        eventBus.PostEvent(afv_native::VoiceServerConnectionResumedEvent {});
+        break;
+    case AfvScriptedEventType::kFrequencyRxBegin: {
+        afv_native::FrequencyRxBeginEvent rxEvent {};
+        rxEvent.frequency = event.frequency;
+        eventBus.PostEvent(rxEvent);
+        break;
+    }
+    case AfvScriptedEventType::kFrequencyRxEnd: {
+        afv_native::FrequencyRxEndEvent rxEvent {};
+        rxEvent.frequency = event.frequency;
+        eventBus.PostEvent(rxEvent);
+        break;
+    }
+    case AfvScriptedEventType::kStationRxBegin: {
+        afv_native::StationRxBeginEvent rxEvent {};
+        rxEvent.frequency = event.frequency;
+        rxEvent.callsign = event.callsign;
+        rxEvent.activeTransmitters = event.activeTransmitters;
+        eventBus.PostEvent(rxEvent);
+        break;
+    }
+    case AfvScriptedEventType::kStationRxEnd: {
+        afv_native::StationRxEndEvent rxEvent {};
+        rxEvent.frequency = event.frequency;
+        rxEvent.callsign = event.callsign;
+        rxEvent.activeTransmitters = event.activeTransmitters;
+        eventBus.PostEvent(rxEvent);
+        break;
+    }
+    case AfvScriptedEventType::kPttOpen:
+        eventBus.PostEvent(afv_native::PttOpenEvent {});
+        break;
+    case AfvScriptedEventType::kPttClosed:
+        eventBus.PostEvent(afv_native::PttClosedEvent {});
+        break;
+    case AfvScriptedEventType::kStationTransceiversUpdated: {
+        afv_native::StationTransceiversUpdatedEvent transceiverEvent {};
+        transceiverEvent.stationName = event.name;
+        eventBus.PostEvent(transceiverEvent);
+        break;
+    }
+    case AfvScriptedEventType::kAudioDeviceStoppedError: {
+        afv_native::AudioDeviceStoppedErrorEvent deviceEvent {};
+        deviceEvent.deviceName = event.name;
+        eventBus.PostEvent(deviceEvent);
+        break;
+    }
+    }
+}
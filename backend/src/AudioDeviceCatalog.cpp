@@ -0,0 +1,159 @@
+#include "AudioDeviceCatalog.hpp"
+#include <plog/Log.h>
+
+AudioDeviceCatalog::AudioDeviceCatalog(
+    AudioDeviceCatalogSource source, std::function<void()> onChanged)
+    : source(std::move(source))
+    , onChanged(std::move(onChanged))
+{
+    worker = std::thread(&AudioDeviceCatalog::run, this);
+}
+
+AudioDeviceCatalog::~AudioDeviceCatalog()
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopRequested = true;
+    }
+    cv.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+AudioApiList AudioDeviceCatalog::apis()
+{
+    std::lock_guard<std::mutex> lock(m);
+    AudioApiList result;
+    if (cachedApis) {
+        result.apis = *cachedApis;
+    }
+    result.refreshing = refreshAll || refreshingAll;
+    return result;
+}
+
+AudioDeviceList AudioDeviceCatalog::devices(unsigned int apiId, bool isInput)
+{
+    return awaitDevices(apiId, isInput, std::chrono::milliseconds(0));
+}
+
+AudioDeviceList AudioDeviceCatalog::awaitDevices(
+    unsigned int apiId, bool isInput, std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(m);
+    lastRequestedApi = apiId;
+
+    DeviceKey key { apiId, isInput };
+    if (cachedDevices.find(key) == cachedDevices.end() && !isRefreshing(apiId)) {
+        pendingApis.insert(apiId);
+        cv.notify_all();
+    }
+
+    if (timeout.count() > 0) {
+        cv.wait_for(lock, timeout, [this, &key] {
+            return stopRequested || cachedDevices.find(key) != cachedDevices.end();
+        });
+    }
+
+    AudioDeviceList result;
+    auto it = cachedDevices.find(key);
+    if (it != cachedDevices.end()) {
+        result.devices = it->second;
+    }
+    result.refreshing = isRefreshing(apiId);
+    return result;
+}
+
+void AudioDeviceCatalog::invalidate()
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        refreshAll = true;
+    }
+    cv.notify_all();
+}
+
+bool AudioDeviceCatalog::isRefreshing(unsigned int apiId) const
+{
+    return refreshAll || refreshingAll || pendingApis.count(apiId) > 0
+        || refreshingApis.count(apiId) > 0;
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+void AudioDeviceCatalog::run()
+{
+    std::unique_lock<std::mutex> lock(m);
+    while (!stopRequested) {
+        bool hasWork = cv.wait_for(lock, kChangeCheckInterval,
+            [this] { return stopRequested || refreshAll || !pendingApis.empty(); });
+        if (stopRequested) {
+            break;
+        }
+
+        // Periodic change check, only the API the user last looked at is re-enumerated
+        bool isChangeCheck = !hasWork;
+        if (isChangeCheck) {
+            if (!lastRequestedApi || (source.isBusy && source.isBusy())) {
+                continue;
+            }
+            pendingApis.insert(*lastRequestedApi);
+        }
+
+        refreshingAll = std::exchange(refreshAll, false);
+        refreshingApis = std::exchange(pendingApis, {});
+        lock.unlock();
+
+        std::optional<std::map<unsigned int, std::string>> newApis;
+        std::map<DeviceKey, std::vector<AudioDeviceInfo>> newDevices;
+        try {
+            std::set<unsigned int> apiIds = refreshingApis;
+            if (refreshingAll) {
+                newApis = source.listApis();
+                for (const auto& [apiId, apiName] : *newApis) {
+                    apiIds.insert(apiId);
+                }
+            }
+            for (auto apiId : apiIds) {
+                newDevices[{ apiId, true }] = source.listDevices(apiId, true);
+                newDevices[{ apiId, false }] = source.listDevices(apiId, false);
+            }
+        } catch (const std::exception& e) {
+            PLOGE << "Error enumerating audio devices: " << e.what();
+        }
+
+        lock.lock();
+        bool changed = false;
+        if (newApis && newApis != cachedApis) {
+            cachedApis = std::move(newApis);
+            changed = true;
+        }
+        for (auto& [key, deviceList] : newDevices) {
+            auto it = cachedDevices.find(key);
+            if (it == cachedDevices.end() || it->second != deviceList) {
+                cachedDevices[key] = std::move(deviceList);
+                changed = true;
+            }
+        }
+
+        // A hot-plugged device most likely shows up under the other APIs too, drop them so they
+        // are enumerated again on their next lookup
+        if (isChangeCheck && changed) {
+            PLOGI << "Audio devices changed, invalidating the device catalog";
+            for (auto it = cachedDevices.begin(); it != cachedDevices.end();) {
+                it = refreshingApis.count(it->first.first) > 0 ? std::next(it)
+                                                               : cachedDevices.erase(it);
+            }
+        }
+
+        refreshingAll = false;
+        refreshingApis.clear();
+        lock.unlock();
+        cv.notify_all();
+
+        if (changed && onChanged) {
+            onChanged();
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,236 @@
+#include "ElectronEventQueue.hpp"
+#include "Helpers.hpp"
+#include <algorithm>
+#include <limits>
+#include <plog/Log.h>
+
+ElectronEventPolicy ElectronEventQueue::policyFor(std::string_view eventName)
+{
+    if (eventName == "station-state-update" || eventName == "main-volume-change"
+        || eventName == "StationTransceiversUpdated" || eventName == "UpdatePttKeyName"
+        || eventName == "AudioDevicesChanged") {
+        return ElectronEventPolicy::kLatest;
+    }
+
+    // Each error pops up a message and plays a sound, once the queue is backed up more of them
+    // only add noise
+    if (eventName == "error") {
+        return ElectronEventPolicy::kBestEffort;
+    }
+
+    return ElectronEventPolicy::kOrdered;
+}
+
+void ElectronEventQueue::push(ElectronEvent&& event)
+{
+    auto policy = policyFor(event.name);
+    auto key = policy == ElectronEventPolicy::kLatest ? coalesceKey(event) : std::string();
+
+    // The sequence is taken and the event queued in one step, so a flush never sees an event
+    // without all the ones numbered before it
+    std::unique_lock<std::mutex> pushLock(pushMutex);
+    event.sequence = nextSequence++;
+    switch (policy) {
+    case ElectronEventPolicy::kLatest: {
+        std::lock_guard<std::mutex> lock(latestMutex);
+        auto [it, inserted] = latestEvents.insert_or_assign(std::move(key), std::move(event));
+        if (!inserted) {
+            coalesced.fetch_add(1, std::memory_order_relaxed);
+        }
+        break;
+    }
+    case ElectronEventPolicy::kBestEffort:
+        if (hasSpilledEvents.load(std::memory_order_acquire)
+            || !pendingEvents.tryPush(std::move(event))) {
+            pushLock.unlock();
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        break;
+    case ElectronEventPolicy::kOrdered:
+        if (hasSpilledEvents.load(std::memory_order_acquire)
+            || !pendingEvents.tryPush(std::move(event))) {
+            std::lock_guard<std::mutex> lock(spillMutex);
+            spilledEvents.push_back(std::move(event));
+            hasSpilledEvents.store(true, std::memory_order_release);
+            spilled.fetch_add(1, std::memory_order_relaxed);
+        }
+        break;
+    }
+    pushLock.unlock();
+
+    scheduleFlush();
+}
+
+ElectronEventQueueStats ElectronEventQueue::stats()
+{
+    ElectronEventQueueStats result;
+    result.delivered = delivered.load(std::memory_order_relaxed);
+    result.batches = batches.load(std::memory_order_relaxed);
+    result.coalesced = coalesced.load(std::memory_order_relaxed);
+    result.dropped = dropped.load(std::memory_order_relaxed);
+    result.spilled = spilled.load(std::memory_order_relaxed);
+    result.pending = pendingEvents.sizeApprox();
+    {
+        std::lock_guard<std::mutex> lock(spillMutex);
+        result.pending += spilledEvents.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(latestMutex);
+        result.pending += latestEvents.size();
+    }
+    return result;
+}
+
+void ElectronEventQueue::scheduleFlush()
+{
+    if (!NapiHelpers::callbackRef || flushScheduled.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    auto status = NapiHelpers::callbackRef->NonBlockingCall(flush);
+    if (status != napi_ok) {
+        PLOGW << "Could not schedule Electron event delivery, status " << status;
+        flushScheduled.store(false, std::memory_order_release);
+    }
+}
+
+void ElectronEventQueue::flush(Napi::Env env, Napi::Function jsCallback)
+{
+    // Clear the flag before draining so an event pushed during the drain schedules a new flush
+    flushScheduled.exchange(false, std::memory_order_acq_rel);
+
+    if (NapiHelpers::_requestExit.load()) {
+        return;
+    }
+
+    // Drained with the producers held off, so the batch is a consistent cut of the push order:
+    // every event numbered before one in the batch is in it or was delivered already
+    std::vector<ElectronEvent> events;
+    std::vector<ElectronEvent> latest;
+    {
+        std::lock_guard<std::mutex> pushLock(pushMutex);
+        ElectronEvent event;
+        while (events.size() < kMaxBatchSize && pendingEvents.tryPop(event)) {
+            events.push_back(std::move(event));
+        }
+
+        // Spilled events were pushed after everything left in the queue, so they only go once
+        // the queue has been drained
+        if (events.size() < kMaxBatchSize && hasSpilledEvents.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(spillMutex);
+            while (events.size() < kMaxBatchSize && !spilledEvents.empty()) {
+                events.push_back(std::move(spilledEvents.front()));
+                spilledEvents.pop_front();
+            }
+            hasSpilledEvents.store(!spilledEvents.empty(), std::memory_order_release);
+        }
+
+        // When the batch is full, ordered events pushed after its last one are still queued and
+        // latest values newer than it wait for the next batch
+        latest = takeLatestEvents(events.size() < kMaxBatchSize
+                ? std::numeric_limits<uint64_t>::max()
+                : events.back().sequence);
+    }
+
+    auto batch = Napi::Array::New(env);
+    uint32_t count = 0;
+    auto nextLatest = latest.begin();
+    for (const auto& orderedEvent : events) {
+        PLOGV << "Event name: " << orderedEvent.name;
+        for (; nextLatest != latest.end() && nextLatest->sequence < orderedEvent.sequence;
+             ++nextLatest) {
+            batch[count++] = toNapi(env, *nextLatest);
+        }
+        batch[count++] = toNapi(env, orderedEvent);
+    }
+    for (; nextLatest != latest.end(); ++nextLatest) {
+        batch[count++] = toNapi(env, *nextLatest);
+    }
+
+    if (count > 0) {
+        delivered.fetch_add(count, std::memory_order_relaxed);
+        batches.fetch_add(1, std::memory_order_relaxed);
+        jsCallback.Call({ batch });
+    }
+
+    if (hasPendingEvents()) {
+        scheduleFlush();
+    }
+}
+
+bool ElectronEventQueue::hasPendingEvents()
+{
+    if (pendingEvents.sizeApprox() > 0 || hasSpilledEvents.load(std::memory_order_acquire)) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(latestMutex);
+    return !latestEvents.empty();
+}
+
+std::vector<ElectronEvent> ElectronEventQueue::takeLatestEvents(uint64_t beforeSequence)
+{
+    std::vector<ElectronEvent> latest;
+    {
+        std::lock_guard<std::mutex> lock(latestMutex);
+        for (auto it = latestEvents.begin(); it != latestEvents.end();) {
+            if (it->second.sequence < beforeSequence) {
+                latest.push_back(std::move(it->second));
+                it = latestEvents.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::sort(latest.begin(), latest.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.sequence < rhs.sequence; });
+    return latest;
+}
+
+std::string ElectronEventQueue::coalesceKey(const ElectronEvent& event)
+{
+    // Station states are kept per frequency, other latest-value events per first argument
+    const auto& first = event.args[0];
+    if (const auto* json = std::get_if<nlohmann::json>(&first)) {
+        if (json->contains("value") && (*json)["value"].contains("frequency")) {
+            return event.name + ":" + (*json)["value"]["frequency"].dump();
+        }
+    } else if (const auto* text = std::get_if<std::string>(&first)) {
+        return event.name + ":" + *text;
+    } else if (const auto* number = std::get_if<double>(&first)) {
+        return event.name + ":" + std::to_string(*number);
+    }
+    return event.name;
+}
+
+Napi::Array ElectronEventQueue::toNapi(Napi::Env env, const ElectronEvent& event)
+{
+    auto entry = Napi::Array::New(env, kMaxElectronEventArgs + 1);
+    entry[uint32_t { 0 }] = Napi::String::New(env, event.name);
+    for (uint32_t i = 0; i < kMaxElectronEventArgs; i++) {
+        entry[i + 1] = std::visit(
+            [&env](const auto& value) -> Napi::Value {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, std::monostate>) {
+                    return env.Undefined();
+                } else if constexpr (std::is_same_v<T, std::string>) {
+                    return Napi::String::New(env, value);
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return Napi::Number::New(env, value);
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    return Napi::Boolean::New(env, value);
+                } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+                    auto napiArr = Napi::Array::New(env, value.size());
+                    for (size_t j = 0; j < value.size(); j++) {
+                        napiArr[j] = Napi::String::New(env, value[j]);
+                    }
+                    return napiArr;
+                } else {
+                    return NapiHelpers::JsonToNapiValue(env, value);
+                }
+            },
+            event.args[i]);
+    }
+    return entry;
+}
@@ -0,0 +1,377 @@
+#include "EvdevJoystickMonitor.hpp"
+#include <plog/Log.h>
+#include <utility>
+
+#ifdef __linux__
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <filesystem>
+#include <limits>
+#include <linux/input.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#ifndef input_event_sec
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+
+namespace {
+constexpr uint64_t kWakeToken = std::numeric_limits<uint64_t>::max();
+
+template <size_t kBitCount> class EvdevBits {
+public:
+    bool test(unsigned int bit) const
+    {
+        return bit < kBitCount && ((words[bit / kBitsPerWord] >> (bit % kBitsPerWord)) & 1UL) != 0;
+    }
+
+    bool any(unsigned int first, unsigned int last) const
+    {
+        for (unsigned int bit = first; bit <= last; bit++) {
+            if (test(bit)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void* data() { return words.data(); }
+    [[nodiscard]] size_t size() const { return sizeof(words); }
+
+private:
+    static constexpr size_t kBitsPerWord = sizeof(unsigned long) * CHAR_BIT;
+    std::array<unsigned long, (kBitCount + kBitsPerWord - 1) / kBitsPerWord> words {};
+};
+
+using KeyBits = EvdevBits<KEY_MAX + 1>;
+using AbsBits = EvdevBits<ABS_MAX + 1>;
+
+struct EvdevDevice {
+    std::string path;
+    int fd = -1;
+    std::string name;
+    input_id id {};
+    KeyBits keys;
+};
+
+// Applies the rules the joydev driver uses to pick up joysticks, without its blacklist
+bool IsJoystick(const KeyBits& keys, const AbsBits& axes)
+{
+    return keys.any(BTN_JOYSTICK, BTN_GAMEPAD - 1) || keys.any(BTN_GAMEPAD, BTN_DIGI - 1)
+        || keys.any(BTN_TRIGGER_HAPPY, BTN_TRIGGER_HAPPY40)
+        || (axes.test(ABS_X) && !keys.test(BTN_TOUCH));
+}
+
+// SFML reads joysticks through joydev, which numbers the buttons from BTN_JOYSTICK up to KEY_MAX
+// first and then from BTN_MISC up to BTN_JOYSTICK
+std::vector<uint16_t> JoydevButtonCodes(const KeyBits& keys)
+{
+    std::vector<uint16_t> codes;
+    for (unsigned int code = BTN_JOYSTICK; code <= KEY_MAX; code++) {
+        if (keys.test(code)) {
+            codes.push_back(static_cast<uint16_t>(code));
+        }
+    }
+    for (unsigned int code = BTN_MISC; code < BTN_JOYSTICK; code++) {
+        if (keys.test(code)) {
+            codes.push_back(static_cast<uint16_t>(code));
+        }
+    }
+    return codes;
+}
+
+std::vector<EvdevDevice> OpenJoystickDevices()
+{
+    std::vector<EvdevDevice> joysticks;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/dev/input", error)) {
+        auto path = entry.path().string();
+        if (entry.path().filename().string().rfind("event", 0) != 0) {
+            continue;
+        }
+
+        int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) {
+            PLOGV << "Cannot open " << path << ": " << std::strerror(errno);
+            continue;
+        }
+
+        EvdevDevice device;
+        device.path = path;
+        device.fd = fd;
+        AbsBits axes;
+        std::array<char, 256> name {};
+        if (ioctl(fd, EVIOCGNAME(name.size() - 1), name.data()) < 0
+            || ioctl(fd, EVIOCGID, &device.id) < 0
+            || ioctl(fd, EVIOCGBIT(EV_KEY, device.keys.size()), device.keys.data()) < 0
+            || ioctl(fd, EVIOCGBIT(EV_ABS, axes.size()), axes.data()) < 0
+            || !IsJoystick(device.keys, axes)) {
+            close(fd);
+            continue;
+        }
+
+        device.name = name.data();
+        joysticks.push_back(std::move(device));
+    }
+
+    if (error) {
+        PLOGD << "Cannot list /dev/input: " << error.message();
+    }
+    return joysticks;
+}
+
+const EvdevDevice* FindDevice(
+    const std::vector<EvdevDevice>& joysticks, const JoystickPttBinding& binding)
+{
+    // SFML reports 0 when it could not read the vendor or product, the name has to do then
+    std::vector<const EvdevDevice*> candidates;
+    for (const auto& joystick : joysticks) {
+        if ((binding.vendorId == 0 || joystick.id.vendor == binding.vendorId)
+            && (binding.productId == 0 || joystick.id.product == binding.productId)) {
+            candidates.push_back(&joystick);
+        }
+    }
+
+    if (candidates.size() > 1) {
+        auto isOtherName
+            = [&](const auto* joystick) { return joystick->name != binding.deviceName; };
+        candidates.erase(
+            std::remove_if(candidates.begin(), candidates.end(), isOtherName), candidates.end());
+    }
+
+    // Two identical joysticks cannot be told apart from SFML's identification
+    return candidates.size() == 1 ? candidates.front() : nullptr;
+}
+
+std::chrono::microseconds EventAge(const input_event& event)
+{
+    timespec now {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return std::chrono::seconds(now.tv_sec - event.input_event_sec)
+        + std::chrono::microseconds(now.tv_nsec / 1000 - event.input_event_usec);
+}
+} // namespace
+
+EvdevJoystickMonitor::EvdevJoystickMonitor(ButtonCallback onButton, DisconnectCallback onDisconnect)
+    : onButton(std::move(onButton))
+    , onDisconnect(std::move(onDisconnect))
+{
+}
+
+EvdevJoystickMonitor::~EvdevJoystickMonitor() { stop(); }
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+bool EvdevJoystickMonitor::start(const std::vector<JoystickPttBinding>& bindings)
+{
+    stop();
+
+    auto joysticks = OpenJoystickDevices();
+    for (const auto& binding : bindings) {
+        const auto* joystick = FindDevice(joysticks, binding);
+        auto codes = joystick ? JoydevButtonCodes(joystick->keys) : std::vector<uint16_t>();
+        if (binding.button < 0 || static_cast<size_t>(binding.button) >= codes.size()) {
+            PLOGD << "No evdev device found for joystick PTT " << binding.pttIndex << " ("
+                  << binding.deviceName << " button " << binding.button << ")";
+            devices.clear();
+            break;
+        }
+
+        auto device = std::find_if(devices.begin(), devices.end(),
+            [&](const auto& bound) { return bound.fd == joystick->fd; });
+        if (device == devices.end()) {
+            device = devices.insert(devices.end(), { joystick->fd, joystick->path, {} });
+        }
+        device->buttons.push_back({ codes[binding.button], binding.pttIndex });
+    }
+
+    bool isComplete = !devices.empty();
+    for (const auto& joystick : joysticks) {
+        bool isBound = std::any_of(devices.begin(), devices.end(),
+            [&](const auto& device) { return device.fd == joystick.fd; });
+        if (!isBound) {
+            close(joystick.fd);
+        }
+    }
+    if (!isComplete) {
+        closeDevices();
+        return false;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    bool isRegistered = epollFd >= 0 && wakeFd >= 0;
+
+    epoll_event wakeEvent {};
+    wakeEvent.events = EPOLLIN;
+    wakeEvent.data.u64 = kWakeToken;
+    isRegistered = isRegistered && epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &wakeEvent) == 0;
+
+    for (size_t i = 0; i < devices.size() && isRegistered; i++) {
+        // Timestamp the events on the clock used to measure their age
+        int clock = CLOCK_MONOTONIC;
+        ioctl(devices[i].fd, EVIOCSCLOCKID, &clock);
+
+        epoll_event deviceEvent {};
+        deviceEvent.events = EPOLLIN;
+        deviceEvent.data.u64 = i;
+        isRegistered = epoll_ctl(epollFd, EPOLL_CTL_ADD, devices[i].fd, &deviceEvent) == 0;
+    }
+
+    if (!isRegistered) {
+        PLOGW << "Cannot listen for joystick events: " << std::strerror(errno);
+        closeDevices();
+        return false;
+    }
+
+    for (const auto& device : devices) {
+        PLOGI << "Listening for " << device.buttons.size() << " joystick PTT button(s) on "
+              << device.path;
+    }
+
+    running = true;
+    worker = std::thread(&EvdevJoystickMonitor::run, this);
+    return true;
+}
+
+void EvdevJoystickMonitor::stop()
+{
+    if (worker.joinable()) {
+        uint64_t wake = 1;
+        if (write(wakeFd, &wake, sizeof(wake)) < 0) {
+            PLOGW << "Cannot wake the joystick monitor: " << std::strerror(errno);
+        }
+        worker.join();
+    }
+    running = false;
+    closeDevices();
+}
+
+void EvdevJoystickMonitor::run()
+{
+    std::array<epoll_event, 8> events {};
+    while (true) {
+        int count = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            PLOGE << "Waiting for joystick events failed: " << std::strerror(errno);
+            break;
+        }
+
+        bool isDisconnected = false;
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.u64 == kWakeToken) {
+                return;
+            }
+            auto& device = devices[events[i].data.u64];
+            if (!readEvents(device)) {
+                PLOGW << "Joystick " << device.path << " disconnected";
+                isDisconnected = true;
+            }
+        }
+
+        if (isDisconnected) {
+            break;
+        }
+    }
+
+    running = false;
+    if (onDisconnect) {
+        onDisconnect();
+    }
+}
+
+bool EvdevJoystickMonitor::readEvents(BoundDevice& device)
+{
+    std::array<input_event, 64> events {};
+    bool isDropped = false;
+    while (true) {
+        ssize_t bytes = read(device.fd, events.data(), sizeof(events));
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        }
+        if (bytes <= 0) {
+            return false;
+        }
+
+        size_t count = static_cast<size_t>(bytes) / sizeof(input_event);
+        for (size_t i = 0; i < count; i++) {
+            const auto& event = events[i];
+            // The kernel dropped events, the button state is read back once it caught up
+            if (event.type == EV_SYN && event.code == SYN_DROPPED) {
+                isDropped = true;
+            } else if (isDropped && event.type == EV_SYN && event.code == SYN_REPORT) {
+                isDropped = false;
+                resyncButtons(device);
+            }
+            // A value of 2 is an autorepeat of a held button
+            if (isDropped || event.type != EV_KEY || event.value == 2) {
+                continue;
+            }
+
+            for (const auto& button : device.buttons) {
+                if (button.code == event.code) {
+                    onButton(button.pttIndex, event.value == 1, EventAge(event));
+                }
+            }
+        }
+    }
+}
+
+void EvdevJoystickMonitor::resyncButtons(const BoundDevice& device)
+{
+    KeyBits keys;
+    if (ioctl(device.fd, EVIOCGKEY(keys.size()), keys.data()) < 0) {
+        return;
+    }
+    for (const auto& button : device.buttons) {
+        onButton(button.pttIndex, keys.test(button.code), std::chrono::microseconds(0));
+    }
+}
+
+void EvdevJoystickMonitor::closeDevices()
+{
+    for (const auto& device : devices) {
+        close(device.fd);
+    }
+    devices.clear();
+    if (epollFd >= 0) {
+        close(epollFd);
+        epollFd = -1;
+    }
+    if (wakeFd >= 0) {
+        close(wakeFd);
+        wakeFd = -1;
+    }
+}
+
+#else
+
+EvdevJoystickMonitor::EvdevJoystickMonitor(ButtonCallback onButton, DisconnectCallback onDisconnect)
+    : onButton(std::move(onButton))
+    , onDisconnect(std::move(onDisconnect))
+{
+}
+
+EvdevJoystickMonitor::~EvdevJoystickMonitor() = default;
+
+bool EvdevJoystickMonitor::start(const std::vector<JoystickPttBinding>& /*bindings*/)
+{
+    return false;
+}
+
+void EvdevJoystickMonitor::stop() { }
+
+#endif
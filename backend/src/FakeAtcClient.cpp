@@ -0,0 +1,282 @@
+#include "FakeAtcClient.hpp"
+#include "AfvEventInjector.hpp"
+#include <plog/Log.h>
+
+namespace {
+void fireEvent(AfvScriptedEventType type, const std::string& name = "")
+{
+    AfvScriptedEvent event;
+    event.type = type;
+    event.name = name;
+    AfvEventInjector::fire(event);
+}
+}
+
+FakeAtcClient::FakeAtcClient(
+    std::string clientName, std::string /*resourcePath*/, std::string /*baseUrl*/)
+{
+    PLOGW << "Using the in-memory fake AFV client (" << clientName
+          << "), no audio or network traffic will happen";
+}
+
+bool FakeAtcClient::Connect()
+{
+    if (voiceConnected.exchange(true)) {
+        return false;
+    }
+    audioRunning = true;
+    fireEvent(AfvScriptedEventType::kVoiceServerConnected);
+    return true;
+}
+
+void FakeAtcClient::Disconnect()
+{
+    if (!voiceConnected.exchange(false)) {
+        return;
+    }
+    audioRunning = false;
+    pttOpen = false;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        radioStates.clear();
+        manualTransceivers.clear();
+    }
+    fireEvent(AfvScriptedEventType::kVoiceServerDisconnected);
+}
+
+bool FakeAtcClient::IsVoiceConnected() const { return voiceConnected.load(); }
+
+void FakeAtcClient::SetCallsign(const std::string& callsign)
+{
+    std::lock_guard<std::mutex> lock(m);
+    this->callsign = callsign;
+}
+
+void FakeAtcClient::SetCredentials(
+    const std::string& /*username*/, const std::string& /*password*/)
+{
+}
+
+void FakeAtcClient::SetClientPosition(
+    double /*lat*/, double /*lon*/, double /*amslm*/, double /*aglm*/)
+{
+}
+
+std::map<unsigned int, std::string> FakeAtcClient::GetAudioApis()
+{
+    return { { 0, "Fake Audio API" } };
+}
+
+std::vector<std::tuple<std::string, std::string, bool>> FakeAtcClient::GetAudioInputDevices(
+    unsigned int /*apiId*/)
+{
+    return { { "fake-input", "Fake Microphone", true } };
+}
+
+std::vector<std::tuple<std::string, std::string, bool>> FakeAtcClient::GetAudioOutputDevices(
+    unsigned int /*apiId*/)
+{
+    return { { "fake-headset", "Fake Headset", true },
+        { "fake-speakers", "Fake Speakers", false } };
+}
+
+void FakeAtcClient::SetAudioApi(unsigned int /*apiId*/) { }
+void FakeAtcClient::SetAudioInputDevice(const std::string& /*deviceId*/) { }
+void FakeAtcClient::SetAudioOutputDevice(const std::string& /*deviceId*/) { }
+void FakeAtcClient::SetAudioSpeakersOutputDevice(const std::string& /*deviceId*/) { }
+
+void FakeAtcClient::StartAudio() { audioRunning = true; }
+void FakeAtcClient::StopAudio() { audioRunning = false; }
+bool FakeAtcClient::IsAudioRunning() const { return audioRunning.load(); }
+
+double FakeAtcClient::GetInputVu() const { return pttOpen ? -0.5 : -0.1; }
+double FakeAtcClient::GetInputPeak() const { return pttOpen ? -0.6 : -0.2; }
+
+void FakeAtcClient::SetMicrophoneVolume(float /*volume*/) { }
+void FakeAtcClient::SetEnableInputFilters(bool /*enabled*/) { }
+void FakeAtcClient::SetEnableOutputEffects(bool /*enabled*/) { }
+void FakeAtcClient::SetHardware(afv_native::HardwareType /*hardware*/) { }
+
+void FakeAtcClient::PlayAdHocSound(const std::string& /*wavFilePath*/, float /*gain*/,
+    afv_native::AdHocOutputTarget /*target*/)
+{
+}
+
+void FakeAtcClient::StopAdHocSounds() { }
+
+void FakeAtcClient::SetLoopback(bool /*enabled*/, afv_native::AdHocOutputTarget /*target*/,
+    float /*gain*/, afv_native::HardwareType /*hardware*/)
+{
+}
+
+bool FakeAtcClient::AddFrequency(unsigned int frequency, const std::string& stationName)
+{
+    std::lock_guard<std::mutex> lock(m);
+    if (radioStates.find(frequency) != radioStates.end()) {
+        return false;
+    }
+    FakeRadioState state;
+    state.stationName = stationName;
+    radioStates.emplace(frequency, std::move(state));
+    return true;
+}
+
+void FakeAtcClient::RemoveFrequency(unsigned int frequency)
+{
+    std::lock_guard<std::mutex> lock(m);
+    radioStates.erase(frequency);
+}
+
+bool FakeAtcClient::IsFrequencyActive(unsigned int frequency)
+{
+    std::lock_guard<std::mutex> lock(m);
+    return radioStates.find(frequency) != radioStates.end();
+}
+
+std::map<unsigned int, FakeRadioState> FakeAtcClient::getRadioState()
+{
+    std::lock_guard<std::mutex> lock(m);
+    return radioStates;
+}
+
+void FakeAtcClient::reset()
+{
+    std::lock_guard<std::mutex> lock(m);
+    radioStates.clear();
+    transceivers.clear();
+    manualTransceivers.clear();
+}
+
+void FakeAtcClient::SetRx(unsigned int frequency, bool active)
+{
+    setField(frequency, &FakeRadioState::rx, active);
+}
+
+void FakeAtcClient::SetTx(unsigned int frequency, bool active)
+{
+    setField(frequency, &FakeRadioState::tx, active);
+}
+
+void FakeAtcClient::SetXc(unsigned int frequency, bool active)
+{
+    setField(frequency, &FakeRadioState::xc, active);
+}
+
+void FakeAtcClient::SetCrossCoupleAcross(unsigned int frequency, bool active)
+{
+    setField(frequency, &FakeRadioState::crossCoupleAcross, active);
+}
+
+void FakeAtcClient::SetOnHeadset(unsigned int frequency, bool onHeadset)
+{
+    setField(frequency, &FakeRadioState::onHeadset, onHeadset);
+}
+
+void FakeAtcClient::SetOutputMute(unsigned int frequency, bool muted)
+{
+    setField(frequency, &FakeRadioState::isOutputMuted, muted);
+}
+
+void FakeAtcClient::SetRadioGain(unsigned int frequency, float gain)
+{
+    setField(frequency, &FakeRadioState::gain, gain);
+}
+
+bool FakeAtcClient::GetRxState(unsigned int frequency)
+{
+    return getField(frequency, &FakeRadioState::rx, false);
+}
+
+bool FakeAtcClient::GetTxState(unsigned int frequency)
+{
+    return getField(frequency, &FakeRadioState::tx, false);
+}
+
+bool FakeAtcClient::GetXcState(unsigned int frequency)
+{
+    return getField(frequency, &FakeRadioState::xc, false);
+}
+
+bool FakeAtcClient::GetCrossCoupleAcrossState(unsigned int frequency)
+{
+    return getField(frequency, &FakeRadioState::crossCoupleAcross, false);
+}
+
+bool FakeAtcClient::GetOnHeadset(unsigned int frequency)
+{
+    return getField(frequency, &FakeRadioState::onHeadset, true);
+}
+
+bool FakeAtcClient::GetIsOutputMutedState(unsigned int frequency)
+{
+    return getField(frequency, &FakeRadioState::isOutputMuted, false);
+}
+
+float FakeAtcClient::GetOutputGainState(unsigned int frequency)
+{
+    return getField(frequency, &FakeRadioState::gain, 1.0f);
+}
+
+void FakeAtcClient::SetPtt(bool pttState)
+{
+    if (!voiceConnected || pttOpen.exchange(pttState) == pttState) {
+        return;
+    }
+    fireEvent(pttState ? AfvScriptedEventType::kPttOpen : AfvScriptedEventType::kPttClosed);
+}
+
+void FakeAtcClient::GetStation(const std::string& /*callsign*/) { }
+void FakeAtcClient::FetchStationVccs(const std::string& /*callsign*/) { }
+
+void FakeAtcClient::FetchTransceiverInfo(const std::string& station)
+{
+    fireEvent(AfvScriptedEventType::kStationTransceiversUpdated, station);
+}
+
+void FakeAtcClient::UseTransceiversFromStation(const std::string& /*station*/, int /*frequency*/)
+{
+}
+
+int FakeAtcClient::GetTransceiverCountForStation(const std::string& station)
+{
+    std::lock_guard<std::mutex> lock(m);
+    auto it = transceivers.find(station);
+    return it != transceivers.end() ? static_cast<int>(it->second.size()) : 0;
+}
+
+std::map<std::string, std::vector<afv_native::afv::dto::StationTransceiver>>
+FakeAtcClient::GetTransceivers()
+{
+    std::lock_guard<std::mutex> lock(m);
+    return transceivers;
+}
+
+void FakeAtcClient::SetManualTransceivers(
+    unsigned int frequency, const std::vector<afv_native::afv::dto::StationTransceiver>& tx)
+{
+    std::lock_guard<std::mutex> lock(m);
+    manualTransceivers.insert_or_assign(frequency, tx);
+}
+
+void FakeAtcClient::SetStationTransceivers(const std::string& station,
+    std::vector<afv_native::afv::dto::StationTransceiver> stationTransceivers, bool notify)
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        transceivers.insert_or_assign(station, std::move(stationTransceivers));
+    }
+    if (notify) {
+        fireEvent(AfvScriptedEventType::kStationTransceiversUpdated, station);
+    }
+}
+
+std::vector<afv_native::afv::dto::StationTransceiver> FakeAtcClient::GetManualTransceivers(
+    unsigned int frequency)
+{
+    std::lock_guard<std::mutex> lock(m);
+    auto it = manualTransceivers.find(frequency);
+    if (it == manualTransceivers.end()) {
+        return {};
+    }
+    return it->second;
+}
@@ -0,0 +1,93 @@
+#include "GuardUnicomTransceivers.hpp"
+#include <algorithm>
+#include <plog/Log.h>
+#include <utility>
+
+namespace {
+bool IsSameTransceiver(const afv_native::afv::dto::StationTransceiver& a,
+    const afv_native::afv::dto::StationTransceiver& b)
+{
+    return a.ID == b.ID && a.Name == b.Name && a.LatDeg == b.LatDeg && a.LonDeg == b.LonDeg
+        && a.HeightMslM == b.HeightMslM && a.HeightAglM == b.HeightAglM;
+}
+
+bool IsSameTransceiverList(const StationTransceiverList& a, const StationTransceiverList& b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), IsSameTransceiver);
+}
+} // namespace
+
+GuardUnicomTransceivers::GuardUnicomTransceivers(GuardUnicomTransceiverSource source)
+    : source(std::move(source))
+    , updateTask(kUpdateInterval, [this]() { update(); })
+{
+}
+
+void GuardUnicomTransceivers::stationUpdated(const std::string& station)
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        updatedStations.insert(station);
+    }
+    updateTask.request();
+}
+
+void GuardUnicomTransceivers::refresh() { updateTask.request(); }
+
+void GuardUnicomTransceivers::invalidate()
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        uploadRequired = true;
+    }
+    updateTask.request();
+}
+
+void GuardUnicomTransceivers::stop() { updateTask.stop(); }
+
+void GuardUnicomTransceivers::update()
+{
+    std::set<std::string> stationsToRead;
+    bool forceUpload = false;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stationsToRead = std::exchange(updatedStations, {});
+        forceUpload = std::exchange(uploadRequired, false);
+    }
+
+    const auto rxStations = source.listRxStations();
+    for (const auto& station : rxStations) {
+        if (cachedTransceivers.find(station) == cachedTransceivers.end()) {
+            stationsToRead.insert(station);
+        }
+    }
+
+    if (!stationsToRead.empty()) {
+        const auto transceivers = source.listTransceivers();
+        for (const auto& station : stationsToRead) {
+            auto it = transceivers.find(station);
+            if (it != transceivers.end()) {
+                cachedTransceivers.insert_or_assign(station, it->second);
+            } else {
+                cachedTransceivers.erase(station);
+            }
+        }
+    }
+
+    StationTransceiverList combined;
+    for (const auto& station : rxStations) {
+        auto it = cachedTransceivers.find(station);
+        if (it != cachedTransceivers.end()) {
+            combined.insert(combined.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    if (!forceUpload && IsSameTransceiverList(combined, uploadedTransceivers)) {
+        PLOGV << "GUARD and UNICOM transceivers unchanged: " << combined.size();
+        return;
+    }
+
+    source.upload(combined);
+    uploadedTransceivers = std::move(combined);
+    PLOGV << "GUARD and UNICOM transceivers set: " << uploadedTransceivers.size();
+}
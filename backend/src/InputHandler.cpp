@@ -1,16 +1,25 @@
 // InputHandler.cpp
 #include "InputHandler.hpp"
 #include "Helpers.hpp"
+#include "PttLatency.hpp"
 #include "Shared.hpp"
 #include <plog/Log.h>
 #include <string>
+#include <utility>
 
 InputHandler::InputHandler()
-    : timer(0, 35)
+    : timer(0, kJoystickPollInterval)
     , uioHookWrapper_(std::make_unique<UIOHookWrapper>())
+    , evdevMonitor(std::make_unique<EvdevJoystickMonitor>(
+          [this](int pttIndex, bool isPressed, std::chrono::microseconds eventAge) {
+              handleEvdevButton(pttIndex, isPressed, eventAge);
+          },
+          [this]() { handleEvdevDisconnect(); }))
 {
     uioHookWrapper_->setEventCallback(
         [this](const uiohook_event* event) { this->handleKeyEvent(event); });
+    // Only key presses and releases are of interest, mouse events are dropped before the callback
+    uioHookWrapper_->setEventMask(UIOHookWrapper::kKeyEvents);
 
     uioHookWrapper_->run();
     timer.start(Poco::TimerCallback<InputHandler>(*this, &InputHandler::onTimer));
@@ -18,6 +27,16 @@ InputHandler::InputHandler()
 
 InputHandler::~InputHandler()
 {
+    {
+        std::lock_guard<std::mutex> lock(m);
+        isStopping = true;
+    }
+
+    // The monitor goes first, a disconnect it reports must not restart the stopped timer
+    {
+        std::lock_guard<std::mutex> lock(evdevMonitorMutex);
+        evdevMonitor->stop();
+    }
     timer.stop();
     uioHookWrapper_->stop();
 }
@@ -28,6 +47,11 @@ void InputHandler::startPttSetup(int pttIndex, bool listenForJoysticks)
     isPttSetupRunning = true;
     this->listenForJoysticks = listenForJoysticks;
     pttSetupIndex = pttIndex;
+
+    // The timer may be idling, joysticks have to be polled for the setup
+    if (listenForJoysticks && !isStopping) {
+        timer.restart(kJoystickPollInterval);
+    }
 }
 
 void InputHandler::clearPtt(int pttIndex)
@@ -60,16 +84,15 @@ void InputHandler::handleKeyEvent(const uiohook_event* event)
 
     int keycode = event->data.keyboard.keycode;
 
-    std::lock_guard<std::mutex> lock(m);
-
-    if (UserSettings::PttKey1 == -1) {
+    // A binding changed after this snapshot only gets its next event handled with the new keys
+    int pttIndex = keyboardPttKeys.load(std::memory_order_acquire).pttIndexOf(keycode);
+    if (pttIndex == 0) {
         return;
     }
 
-    checkKeyboardPtt(
-        1, UserSettings::PttKey1, UserSettings::isJoystickButton1, isKeyPressed, keycode);
-    checkKeyboardPtt(
-        2, UserSettings::PttKey2, UserSettings::isJoystickButton2, isKeyPressed, keycode);
+    auto eventTime = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m);
+    checkKeyboardPtt(pttIndex, isKeyPressed, eventTime);
 }
 
 bool InputHandler::handlePttSetup(const uiohook_event* event)
@@ -95,19 +118,16 @@ bool InputHandler::handlePttSetup(const uiohook_event* event)
 }
 
 void InputHandler::checkKeyboardPtt(
-    int pttIndex, int pttKey, bool isJoystickButton, bool isKeyPressed, int keycode)
+    int pttIndex, bool isKeyPressed, std::chrono::steady_clock::time_point eventTime)
 {
-    if (!mClient || isJoystickButton || (activePtt != 0 && activePtt != pttIndex)) {
-        return;
-    }
-
-    bool isPttKey = keycode == pttKey;
-    if (!isPttKey) {
+    if (!mClient || (activePtt != 0 && activePtt != pttIndex)) {
         return;
     }
 
     if (isKeyPressed && !isPttOpen) {
+        PttLatency::begin(PttInputSource::kKeyboard, eventTime);
         mClient->SetPtt(true);
+        PttLatency::mark(PttLatencyStage::kSetPtt);
         isPttOpen = true;
         activePtt = pttIndex;
     } else if (!isKeyPressed && isPttOpen) {
@@ -119,28 +139,73 @@ void InputHandler::checkKeyboardPtt(
 
 void InputHandler::checkJoystickPtt(int pttIndex, int key, int joystickId)
 {
-    if (!mClient || (activePtt != 0 && activePtt != pttIndex)
-        || !sf::Joystick::isConnected(joystickId)) {
+    if (!sf::Joystick::isConnected(joystickId)) {
         return;
     }
 
     bool isButtonPressed = sf::Joystick::isButtonPressed(joystickId, key);
+    auto pollGap = joystickPollTime - previousJoystickPoll;
+    if (setJoystickPtt(
+            pttIndex, isButtonPressed, PttInputSource::kJoystickPoll, joystickPollTime)) {
+        PLOGV << "Joystick PTT " << pttIndex << (isButtonPressed ? " pressed" : " released")
+              << " via SFML, up to "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(pollGap).count()
+              << " ms after the button";
+    }
+}
+
+bool InputHandler::setJoystickPtt(int pttIndex, bool isButtonPressed, PttInputSource source,
+    std::chrono::steady_clock::time_point eventTime)
+{
+    if (!mClient || (activePtt != 0 && activePtt != pttIndex)) {
+        return false;
+    }
+
     if (isButtonPressed && !isPttOpen) {
+        PttLatency::begin(source, eventTime);
         mClient->SetPtt(true);
+        PttLatency::mark(PttLatencyStage::kSetPtt);
         isPttOpen = true;
         activePtt = pttIndex;
-    } else if (!isButtonPressed && isPttOpen) {
+        return true;
+    }
+    if (!isButtonPressed && isPttOpen) {
         mClient->SetPtt(false);
         isPttOpen = false;
         activePtt = 0;
+        return true;
     }
+    return false;
 }
 
-void InputHandler::onTimer(Poco::Timer& /*timer*/)
+void InputHandler::onTimer(Poco::Timer& /*firedTimer*/)
 {
-    sf::Joystick::update();
+    updateEvdevMonitor();
+    bool isEvdevActive = evdevMonitor->isRunning();
 
     std::lock_guard<std::mutex> lock(m);
+    // Timer::stop() waits for this tick with the interval set to 0, setting it again would keep
+    // the timer running forever
+    if (isStopping) {
+        return;
+    }
+
+    bool isJoystickSetup = isPttSetupRunning && listenForJoysticks;
+    bool hasJoystickPtt = UserSettings::PttKey1 != -1
+        && (UserSettings::isJoystickButton1 || UserSettings::isJoystickButton2);
+
+    bool isPolling = isJoystickSetup || (hasJoystickPtt && !isEvdevActive);
+    if (isPolling) {
+        pollJoysticks(isEvdevActive);
+    }
+
+    timer.setPeriodicInterval(isPolling ? kJoystickPollInterval : kIdleInterval);
+}
+
+void InputHandler::pollJoysticks(bool isEvdevActive)
+{
+    previousJoystickPoll = std::exchange(joystickPollTime, std::chrono::steady_clock::now());
+    sf::Joystick::update();
 
     // If PTT is active on a joystick that got disconnected, force-release PTT
     if (mClient && isPttOpen
@@ -154,19 +219,105 @@ void InputHandler::onTimer(Poco::Timer& /*timer*/)
         activePtt = 0;
     }
 
-    if (handleJoystickSetup()) {
+    if (!handleJoystickSetup() && !isEvdevActive && UserSettings::PttKey1 != -1) {
+        if (UserSettings::isJoystickButton1) {
+            checkJoystickPtt(1, UserSettings::PttKey1, UserSettings::JoystickId1);
+        }
+        if (UserSettings::isJoystickButton2) {
+            checkJoystickPtt(2, UserSettings::PttKey2, UserSettings::JoystickId2);
+        }
+    }
+}
+
+void InputHandler::updateEvdevMonitor()
+{
+    std::lock_guard<std::mutex> evdevLock(evdevMonitorMutex);
+    if (isStopping) {
         return;
     }
 
-    if (UserSettings::PttKey1 == -1) {
+    auto now = std::chrono::steady_clock::now();
+    if (isEvdevLost.exchange(false)) {
+        evdevMonitor->stop();
+        evdevRetryAt = now + kEvdevRetryInterval;
+    }
+
+    std::vector<JoystickButton> buttons;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if (UserSettings::PttKey1 != -1 && UserSettings::isJoystickButton1) {
+            buttons.push_back({ 1, UserSettings::JoystickId1, UserSettings::PttKey1 });
+        }
+        if (UserSettings::PttKey1 != -1 && UserSettings::isJoystickButton2) {
+            buttons.push_back({ 2, UserSettings::JoystickId2, UserSettings::PttKey2 });
+        }
+    }
+
+    bool isChanged = buttons != evdevButtons;
+    if (!isChanged && (buttons.empty() || evdevMonitor->isRunning() || now < evdevRetryAt)) {
+        return;
+    }
+
+    evdevMonitor->stop();
+    evdevButtons = buttons;
+    evdevRetryAt = now + kEvdevRetryInterval;
+    if (buttons.empty()) {
+        return;
+    }
+
+    // The bindings are stored as SFML joystick ids, the monitor finds the evdev device by the
+    // identification SFML reports for them
+    sf::Joystick::update();
+    std::vector<JoystickPttBinding> bindings;
+    for (const auto& button : buttons) {
+        if (!sf::Joystick::isConnected(button.joystickId)) {
+            return;
+        }
+        auto identification = sf::Joystick::getIdentification(button.joystickId);
+        bindings.push_back({ button.pttIndex, std::string(identification.name),
+            identification.vendorId, identification.productId, button.button });
+    }
+
+    if (evdevMonitor->start(bindings)) {
+        PLOGI << "Joystick PTT is handled on evdev events";
+    } else if (isChanged) {
+        PLOGI << "Joystick PTT is polled every " << kJoystickPollInterval << " ms";
+    }
+}
+
+void InputHandler::handleEvdevButton(
+    int pttIndex, bool isPressed, std::chrono::microseconds eventAge)
+{
+    std::lock_guard<std::mutex> lock(m);
+
+    // Joystick buttons are being bound, the polling handles them
+    if (isPttSetupRunning && listenForJoysticks) {
         return;
     }
 
-    if (UserSettings::isJoystickButton1) {
-        checkJoystickPtt(1, UserSettings::PttKey1, UserSettings::JoystickId1);
+    auto eventTime = std::chrono::steady_clock::now() - eventAge;
+    if (setJoystickPtt(pttIndex, isPressed, PttInputSource::kJoystickEvdev, eventTime)) {
+        PLOGV << "Joystick PTT " << pttIndex << (isPressed ? " pressed" : " released")
+              << " via evdev, " << eventAge.count() << " us after the button";
+    }
+}
+
+void InputHandler::handleEvdevDisconnect()
+{
+    std::lock_guard<std::mutex> lock(m);
+    if (mClient && isPttOpen
+        && ((activePtt == 1 && UserSettings::isJoystickButton1)
+            || (activePtt == 2 && UserSettings::isJoystickButton2))) {
+        PLOGW << "Joystick disconnected during active PTT, forcing release";
+        mClient->SetPtt(false);
+        isPttOpen = false;
+        activePtt = 0;
     }
-    if (UserSettings::isJoystickButton2) {
-        checkJoystickPtt(2, UserSettings::PttKey2, UserSettings::JoystickId2);
+
+    // Falls back to polling until the joystick is back
+    isEvdevLost = true;
+    if (!isStopping) {
+        timer.restart(kJoystickPollInterval);
     }
 }
 
@@ -208,13 +359,24 @@ void InputHandler::updatePttKey(int pttIndex, int key, bool isJoystickButton, in
     }
 
     UserSettings::save();
+    publishPttBindings();
     InputHandler::forwardPttKeyName(pttIndex);
 }
 
+void InputHandler::publishPttBindings()
+{
+    // PTT 2 only works once PTT 1 is set
+    KeyboardPttKeys keys;
+    if (UserSettings::PttKey1 != -1) {
+        keys.ptt1 = UserSettings::isJoystickButton1 ? -1 : UserSettings::PttKey1;
+        keys.ptt2 = UserSettings::isJoystickButton2 ? -1 : UserSettings::PttKey2;
+    }
+    keyboardPttKeys.store(keys, std::memory_order_release);
+}
+
 void InputHandler::forwardPttKeyName(int pttIndex)
 {
-    NapiHelpers::callElectron(
-        "UpdatePttKeyName", std::to_string(pttIndex), getPttKeyName(pttIndex));
+    NapiHelpers::callElectron("UpdatePttKeyName", pttIndex, getPttKeyName(pttIndex));
 }
 
 std::string InputHandler::lookupPttKeyName(int key, bool isJoystickButton, int joystickId)
@@ -0,0 +1,115 @@
+#include "PttLatency.hpp"
+#include <algorithm>
+
+namespace {
+constexpr std::array<const char*, 5> kStageNames
+    = { "input", "decision", "setPtt", "afvPttOpen", "sdkTxBegin" };
+constexpr std::array<const char*, 3> kSourceNames = { "keyboard", "joystickEvdev", "joystickPoll" };
+
+double ToUs(int64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1000.0; }
+} // namespace
+
+void LatencyHistogram::add(std::chrono::nanoseconds latency)
+{
+    auto latencyNs = std::max<int64_t>(latency.count(), 0);
+    auto latencyUs = latencyNs / 1000;
+    auto bound = std::lower_bound(kBucketBoundsUs.begin(), kBucketBoundsUs.end(), latencyUs);
+    buckets[static_cast<size_t>(bound - kBucketBoundsUs.begin())]++;
+
+    count++;
+    totalNs += latencyNs;
+    maxNs = std::max(maxNs, latencyNs);
+}
+
+double LatencyHistogram::quantileUs(double quantile) const
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    auto rank = static_cast<uint64_t>(quantile * static_cast<double>(count - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketBoundsUs.size(); i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(static_cast<double>(kBucketBoundsUs[i]), ToUs(maxNs));
+        }
+    }
+    return ToUs(maxNs);
+}
+
+nlohmann::json LatencyHistogram::toJson() const
+{
+    auto bucketList = nlohmann::json::array();
+    for (size_t i = 0; i < buckets.size(); i++) {
+        if (buckets[i] == 0) {
+            continue;
+        }
+        nlohmann::json bucket = { { "count", buckets[i] } };
+        bucket["maxUs"] = i < kBucketBoundsUs.size() ? nlohmann::json(kBucketBoundsUs[i])
+                                                     : nlohmann::json(nullptr);
+        bucketList.push_back(bucket);
+    }
+
+    return { { "count", count },
+        { "meanUs", count > 0 ? ToUs(totalNs) / static_cast<double>(count) : 0.0 },
+        { "p50Us", quantileUs(0.5) }, { "p95Us", quantileUs(0.95) },
+        { "p99Us", quantileUs(0.99) }, { "maxUs", ToUs(maxNs) }, { "buckets", bucketList } };
+}
+
+void PttLatency::begin(PttInputSource source, std::chrono::steady_clock::time_point eventTime)
+{
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m);
+    isSampling = true;
+    inputTime = eventTime;
+    lastStage = PttLatencyStage::kDecision;
+    lastStageTime = now;
+    stageLatencies[static_cast<size_t>(PttLatencyStage::kDecision)].add(now - eventTime);
+    samplesBySource[static_cast<size_t>(source)]++;
+}
+
+void PttLatency::mark(PttLatencyStage stage)
+{
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m);
+    if (!isSampling || stage <= lastStage || now - inputTime > kSampleTimeout) {
+        return;
+    }
+
+    stageLatencies[static_cast<size_t>(stage)].add(now - lastStageTime);
+    lastStage = stage;
+    lastStageTime = now;
+
+    if (stage == PttLatencyStage::kAfvPttOpen) {
+        endToEnd.add(now - inputTime);
+    }
+    if (stage == PttLatencyStage::kSdkTxBegin) {
+        isSampling = false;
+    }
+}
+
+nlohmann::json PttLatency::report()
+{
+    std::lock_guard<std::mutex> lock(m);
+    auto stages = nlohmann::json::object();
+    for (size_t i = 1; i < kStageCount; i++) {
+        stages[kStageNames[i]] = stageLatencies[i].toJson();
+    }
+
+    auto sources = nlohmann::json::object();
+    for (size_t i = 0; i < kSourceCount; i++) {
+        sources[kSourceNames[i]] = samplesBySource[i];
+    }
+
+    return { { "stages", stages }, { "endToEnd", endToEnd.toJson() }, { "sources", sources } };
+}
+
+void PttLatency::reset()
+{
+    std::lock_guard<std::mutex> lock(m);
+    isSampling = false;
+    stageLatencies = {};
+    endToEnd = {};
+    samplesBySource = {};
+}
@@ -1,20 +1,69 @@
 #include "RemoteData.hpp"
 #include "Helpers.hpp"
 #include "Shared.hpp"
-#include <absl/strings/match.h>
-#include <map>
+#include "SlurperParser.hpp"
+#include <algorithm>
 #include <plog/Log.h>
+#include <vector>
 
-RemoteData::RemoteData()
-    : timer(static_cast<long>(3 * 1000), static_cast<long>(TIMER_CALLBACK_INTERVAL_SEC * 1000))
+RemoteData::RemoteData(std::function<void(const NetworkSession&)> onSessionChanged)
+    : onSessionChanged(std::move(onSessionChanged))
 {
-    timer.start(Poco::TimerCallback<RemoteData>(*this, &RemoteData::onTimer));
+    worker = std::thread(&RemoteData::run, this);
 }
 
-void RemoteData::onTimer(Poco::Timer& /*timer*/)
+RemoteData::~RemoteData()
 {
-    std::lock_guard<std::mutex> lock(m); // Prevent double updates in case of a slow network
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopRequested = true;
+        // Abort a poll in flight rather than waiting for its timeouts
+        if (slurperClient) {
+            slurperClient->stop();
+        }
+    }
+    cv.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void RemoteData::pollSoon()
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        pollRequested = true;
+        fastPollUntil = std::chrono::steady_clock::now() + kFastPollWindow;
+    }
+    cv.notify_all();
+}
+
+NetworkSession RemoteData::currentSession()
+{
+    std::lock_guard<std::mutex> lock(m);
+    return reportedSession;
+}
 
+void RemoteData::run()
+{
+    std::unique_lock<std::mutex> lock(m);
+    std::chrono::milliseconds delay = kInitialPollDelay;
+    while (true) {
+        cv.wait_for(lock, delay, [this] { return stopRequested || pollRequested; });
+        if (stopRequested) {
+            return;
+        }
+        pollRequested = false;
+
+        lock.unlock();
+        delay = poll();
+        lock.lock();
+    }
+}
+
+std::chrono::milliseconds RemoteData::poll()
+{
     // Copy CID under the session lock, then release it before the blocking HTTP call
     std::string cid;
     bool isDebug = false;
@@ -27,26 +76,46 @@ void RemoteData::onTimer(Poco::Timer& /*timer*/)
     }
 
     if (isDebug) {
-        std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
-        updateSessionStatus(previousCallsign, true);
-        return;
+        std::optional<NetworkSession> session;
+        {
+            std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
+            session = updateSessionStatus(previousCallsign, true);
+        }
+        if (session) {
+            notifySessionChange(*session);
+        }
+        return kPollInterval;
+    }
+    if (cid.empty()) {
+        return nextPollDelay(false);
     }
+
     try {
+        const std::string previousBody = slurperCache.cid == cid ? slurperCache.body : "";
         auto slurperData = getSlurperData(cid);
         if (!slurperData.has_value()) {
             // The slurper could not be reached. getSlurperData handles the grace
             // period and unavailability notifications internally; leave the session
             // state untouched so an outage is not treated as a disconnect.
-            return;
+            return nextBackoffDelay();
         }
         // Successful fetch — reset grace period
         enteredSlurperGracePeriod = false;
+        failedPolls = 0;
+        const bool unchanged = *slurperData == previousBody;
         // Re-acquire session lock for parsing and updating session state.
         // An empty body is authoritative: it means the CID has no active
         // connection, so the session must be torn down.
-        std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
-        auto isConnected = parseSlurper(*slurperData);
-        updateSessionStatus(previousCallsign, isConnected);
+        std::optional<NetworkSession> session;
+        {
+            std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
+            auto isConnected = parseSlurper(*slurperData);
+            session = updateSessionStatus(previousCallsign, isConnected);
+        }
+        if (session) {
+            notifySessionChange(*session);
+        }
+        return nextPollDelay(unchanged);
     } catch (const std::exception& ex) {
         RemoteDataStatus::isSlurperAvailable = false;
         enteredSlurperGracePeriod = false;
@@ -58,6 +127,48 @@ void RemoteData::onTimer(Poco::Timer& /*timer*/)
         PLOG_ERROR << "Error while parsing slurper data.";
         notifyUserOfSlurperUnavalability();
     }
+    return nextBackoffDelay();
+}
+
+std::chrono::milliseconds RemoteData::nextPollDelay(bool unchanged)
+{
+    unchangedPolls = unchanged ? unchangedPolls + 1 : 0;
+
+    bool isFastPolling = false;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        isFastPolling = std::chrono::steady_clock::now() < fastPollUntil;
+    }
+
+    if (isFastPolling) {
+        return kFastPollInterval;
+    }
+    return unchangedPolls >= kPollsUntilStable ? kStablePollInterval : kPollInterval;
+}
+
+std::chrono::milliseconds RemoteData::nextBackoffDelay()
+{
+    unchangedPolls = 0;
+    failedPolls++;
+
+    // The first failure is retried quickly, as it is most likely a one-off
+    if (failedPolls == 1) {
+        return kFastPollInterval;
+    }
+
+    std::chrono::milliseconds backoff = kPollInterval;
+    for (int i = 2; i < failedPolls && backoff < kMaxBackoffInterval; i++) {
+        backoff *= 2;
+    }
+    backoff = std::min<std::chrono::milliseconds>(backoff, kMaxBackoffInterval);
+
+    // Spread the retries of all clients over the second half of the interval
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(
+        backoff.count() / 2, backoff.count());
+    auto delay = std::chrono::milliseconds(jitter(backoffJitter));
+    PLOGV << "Slurper unreachable " << failedPolls << " times, next poll in " << delay.count()
+          << "ms";
+    return delay;
 }
 
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
@@ -67,13 +178,34 @@ std::optional<std::string> RemoteData::getSlurperData(const std::string& cid)
         return std::nullopt;
     }
 
-    httplib::Client slurperCli(SLURPER_BASE_URL);
-    slurperCli.set_follow_location(true);
-    slurperCli.set_connection_timeout(10);
-    slurperCli.set_read_timeout(10);
-    auto res = slurperCli.Get(SLURPER_DATA_ENDPOINT + std::string("?cid=") + cid);
+    if (slurperCache.cid != cid) {
+        slurperCache = SlurperResponseCache { cid, "", "", "" };
+    }
+
+    httplib::Headers headers;
+    if (!slurperCache.etag.empty()) {
+        headers.emplace("If-None-Match", slurperCache.etag);
+    }
+    if (!slurperCache.lastModified.empty()) {
+        headers.emplace("If-Modified-Since", slurperCache.lastModified);
+    }
+
+    auto slurperCli = getSlurperClient();
+    if (!slurperCli) {
+        return std::nullopt;
+    }
+    const bool reusedConnection = slurperCli->is_socket_open();
+    const auto pollStart = std::chrono::steady_clock::now();
+    auto res = slurperCli->Get(SLURPER_DATA_ENDPOINT + std::string("?cid=") + cid, headers);
+    if (isStopping()) {
+        return std::nullopt; // Cancelled, not an outage
+    }
+    recordSlurperPoll(std::chrono::steady_clock::now() - pollStart, reusedConnection);
 
     if (!res) {
+        // Start over with a fresh connection on the next poll
+        resetSlurperClient();
+
         // Notify the client the slurper is offline
         if (!enteredSlurperGracePeriod) {
             enteredSlurperGracePeriod = true;
@@ -87,7 +219,9 @@ std::optional<std::string> RemoteData::getSlurperData(const std::string& cid)
         return std::nullopt;
     }
 
-    if (res->status != httplib::StatusCode::OK_200) {
+    const bool notModified = res->status == httplib::StatusCode::NotModified_304
+        && (!slurperCache.etag.empty() || !slurperCache.lastModified.empty());
+    if (res->status != httplib::StatusCode::OK_200 && !notModified) {
         if (!enteredSlurperGracePeriod) {
             enteredSlurperGracePeriod = true;
             PLOG_ERROR << "Slurper returned an HTTP error " << res->status
@@ -111,87 +245,93 @@ std::optional<std::string> RemoteData::getSlurperData(const std::string& cid)
         enteredSlurperGracePeriod = false;
     }
 
+    if (notModified) {
+        PLOGV << "Slurper data not modified";
+        return slurperCache.body;
+    }
+
+    slurperCache.etag = res->get_header_value("ETag");
+    slurperCache.lastModified = res->get_header_value("Last-Modified");
+    slurperCache.body = res->body;
     return res->body;
 }
-// NOLINTNEXTLINE
-bool RemoteData::parseSlurper(const std::string& sluper_data)
+std::shared_ptr<httplib::Client> RemoteData::getSlurperClient()
 {
-    if (sluper_data.empty()) {
-        return false;
+    std::lock_guard<std::mutex> lock(m);
+    if (stopRequested) {
+        return nullptr;
     }
+    auto baseUrl = RemoteEndpoints::getSlurperBaseUrl();
+    if (!slurperClient || slurperClientBaseUrl != baseUrl) {
+        slurperClient = std::make_shared<httplib::Client>(baseUrl);
+        slurperClientBaseUrl = baseUrl;
+        slurperClient->set_keep_alive(true);
+        slurperClient->set_follow_location(true);
+        slurperClient->set_connection_timeout(10);
+        slurperClient->set_read_timeout(10);
+    }
+    return slurperClient;
+}
 
-    auto lines = absl::StrSplit(sluper_data, '\n');
-
-    std::multimap<ConnectionType, ConnectionInfo> connections;
-
-    for (const auto& line : lines) {
-        pYx = false;
-        bool isPilot = false;
-        if (line.empty()) {
-            continue;
-        }
-
-        std::vector<std::string> res = absl::StrSplit(line, ',');
-
-        if (res.size() < 7) {
-            continue;
-        }
-
-        if (absl::EndsWith(res[2], "_ATIS")) {
-            continue;
-        }
-
-        if (res[2] == "DCLIENT3") {
-            continue;
-        }
-
-        if (res[3] == "pilot") {
-            isPilot = true;
-        }
+void RemoteData::resetSlurperClient()
+{
+    std::lock_guard<std::mutex> lock(m);
+    slurperClient.reset();
+}
 
-        ConnectionInfo connection;
-        connection.callsign = res[1];
-        connection.res3 = res[3];
-        connection.res2 = res[2];
-        connection.lat = res[5];
-        connection.lon = res[6];
+bool RemoteData::isStopping()
+{
+    std::lock_guard<std::mutex> lock(m);
+    return stopRequested;
+}
 
-        connections.emplace(getPyx_00z(isPilot, res[1]), connection);
+void RemoteData::recordSlurperPoll(
+    std::chrono::steady_clock::duration duration, bool reusedConnection)
+{
+    const auto durationMs
+        = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    slurperPolls++;
+    if (reusedConnection) {
+        slurperConnectionReuses++;
     }
 
-    if (connections.empty()) {
-        return false;
+    recentPollDurationsMs.push_back(durationMs);
+    if (recentPollDurationsMs.size() > kPollStatsWindow) {
+        recentPollDurationsMs.pop_front();
     }
-
-    auto it1 = connections.find(ConnectionType::z1);
-    auto it2 = connections.find(ConnectionType::op);
-    if (it1 == connections.end() && it2 == connections.end()) {
-        return false;
+    PLOGV << "Slurper poll took " << durationMs << "ms"
+          << (reusedConnection ? " on a reused connection" : " on a new connection");
+
+    if (slurperPolls % kPollStatsWindow == 0) {
+        std::vector<int64_t> sorted(recentPollDurationsMs.begin(), recentPollDurationsMs.end());
+        auto median = sorted.begin() + static_cast<std::ptrdiff_t>(sorted.size() / 2);
+        std::nth_element(sorted.begin(), median, sorted.end());
+        PLOGD << "Slurper polls: " << slurperPolls << ", reused connections: "
+              << slurperConnectionReuses << ", median of the last " << sorted.size()
+              << " polls: " << *median << "ms";
     }
+}
 
-    if (it1 == connections.end()) {
-        it1 = it2;
+// NOLINTNEXTLINE
+bool RemoteData::parseSlurper(std::string_view sluper_data)
+{
+    auto connection = SlurperParser::parse(sluper_data);
+    if (!connection) {
+        return false;
     }
 
-    std::string res3 = it1->second.res3;
-
-    res3.erase(std::remove(res3.begin(), res3.end(), '.'), res3.end());
-    // NOLINTNEXTLINE Handled above in the try catch block
-    int u334 = std::atoi(res3.c_str()) * 1000;
-
-    auto cleanedFrequency = Helpers::CleanUpFrequency(u334);
-    if (UserSession::callsign == it1->second.callsign && UserSession::frequency == cleanedFrequency
-        && UserSession::xy == (it1->first == ConnectionType::z1)
-        && UserSession::lat == std::stod(it1->second.lat)
-        && UserSession::lon == std::stod(it1->second.lon)) {
+    auto cleanedFrequency = Helpers::CleanUpFrequency(connection->frequency);
+    if (UserSession::callsign == connection->callsign
+        && UserSession::frequency == cleanedFrequency && UserSession::xy == connection->isAtc
+        && UserSession::lat == connection->lat && UserSession::lon == connection->lon) {
         return true; // No changes
     }
     // Update the session info
-    UserSession::callsign = it1->second.callsign;
+    UserSession::callsign = connection->callsign;
     UserSession::frequency = cleanedFrequency;
-    UserSession::xy = (it1->first == ConnectionType::z1);
-    UserSession::lat = std::stod(it1->second.lat);
-    UserSession::lon = std::stod(it1->second.lon);
+    UserSession::xy = connection->isAtc;
+    UserSession::lat = connection->lat;
+    UserSession::lon = connection->lon;
     PLOG_INFO << "Updating session data - Callsign: " << UserSession::callsign
               << ", Frequency: " << UserSession::frequency
               << ", xx: " << static_cast<int>(UserSession::xy) << ", Latitude: " << UserSession::lat
@@ -199,10 +339,11 @@ bool RemoteData::parseSlurper(const std::string& sluper_data)
     return true;
 }
 
-void RemoteData::updateSessionStatus(const std::string& previousCallsign, bool isConnected)
+std::optional<NetworkSession> RemoteData::updateSessionStatus(
+    const std::string& previousCallsign, bool isConnected)
 {
     if (!mClient) {
-        return;
+        return std::nullopt;
     }
 
     if (UserSession::isConnectedToTheNetwork && UserSession::callsign != previousCallsign
@@ -216,15 +357,16 @@ void RemoteData::updateSessionStatus(const std::string& previousCallsign, bool i
 
     if (isConnected) {
         // We are now connected to the network
-        // We update the session state
-        std::string callsign = UserSession::callsign;
-        std::string isatc = UserSession::xy ? "1" : "0";
-        std::string combinedString = isatc + "," + std::to_string(UserSession::frequency);
-
-        NapiHelpers::callElectron("network-connected", callsign, combinedString);
-
         UserSession::isConnectedToTheNetwork = true;
-        return;
+
+        NetworkSession session;
+        session.isConnected = true;
+        session.callsign = UserSession::callsign;
+        session.frequency = UserSession::frequency;
+        session.isAtc = UserSession::xy;
+        session.lat = UserSession::lat;
+        session.lon = UserSession::lon;
+        return session;
     } else {
         if (mClient->IsVoiceConnected()) {
             // Notify before disconnecting: Disconnect() tears down the audio device
@@ -240,8 +382,42 @@ void RemoteData::updateSessionStatus(const std::string& previousCallsign, bool i
         UserSession::xy = false;
         UserSession::callsign = "";
 
+        return NetworkSession {};
+    }
+}
+
+void RemoteData::notifySessionChange(const NetworkSession& session)
+{
+    if (lastSession && *lastSession == session) {
+        // Only the position moved, kept for currentSession() without notifying
+        lastSession = session;
+        std::lock_guard<std::mutex> lock(m);
+        reportedSession = session;
+        return;
+    }
+
+    const bool wasConnected = lastSession && lastSession->isConnected;
+    if (session.isConnected && !wasConnected) {
+        NapiHelpers::callElectron(
+            "network-connected", session.callsign, session.isAtc, session.frequency);
+    } else if (session.isConnected) {
+        NapiHelpers::callElectron("network-session-changed",
+            nlohmann::json { { "callsign", session.callsign }, { "isAtc", session.isAtc },
+                { "frequency", session.frequency }, { "lat", session.lat },
+                { "lon", session.lon } });
+    } else {
         NapiHelpers::callElectron("network-disconnected");
     }
+    PLOGV << "Network session changed, connected: " << session.isConnected;
+
+    lastSession = session;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        reportedSession = session;
+    }
+    if (onSessionChanged) {
+        onSessionChanged(session);
+    }
 }
 
 void RemoteData::notifyUserOfSlurperAvailability() const
@@ -4,7 +4,7 @@
 
 const semver::version VERSION = semver::version { 1, 4, 0, semver::prerelease::beta, 10 };
 const std::string CLIENT_NAME = std::string("TrackAudio-") + VERSION.to_string();
-std::unique_ptr<afv_native::api::atcClient> mClient = nullptr;
+std::unique_ptr<AtcClient> mClient = nullptr;
 
 // Initialize static members
 int UserAudioSetting::apiId = 0;
@@ -19,13 +19,29 @@ double UserSession::lat = 0.0;
 double UserSession::lon = 0.0;
 bool UserSession::xy = false;
 bool UserSession::isConnectedToTheNetwork = false;
-float UserSession::currentMainVolume = 100;
+std::atomic<float> UserSession::currentMainVolume = 100;
 bool UserSession::isDebug = false;
-std::map<unsigned int, float> UserSession::stationVolumes = {};
+ChannelVolumeTable UserSession::stationVolumes;
 std::mutex UserSession::mtx;
 
 bool RemoteDataStatus::isSlurperAvailable = false;
 
+std::string RemoteEndpoints::slurperBaseUrl = SLURPER_BASE_URL;
+std::string RemoteEndpoints::versionCheckBaseUrl = VERSION_CHECK_BASE_URL;
+std::mutex RemoteEndpoints::mtx;
+
+std::string RemoteEndpoints::getSlurperBaseUrl()
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return slurperBaseUrl;
+}
+
+std::string RemoteEndpoints::getVersionCheckBaseUrl()
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return versionCheckBaseUrl;
+}
+
 int UserSettings::configVersion = 0;
 int UserSettings::PttKey1 = -1;
 int UserSettings::JoystickId1 = 0;
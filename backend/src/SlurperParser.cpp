@@ -0,0 +1,116 @@
+#include "SlurperParser.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+// Splits off the text up to the next delimiter, the rest is left in text
+std::string_view NextToken(std::string_view& text, char delimiter)
+{
+    auto pos = text.find(delimiter);
+    auto token = text.substr(0, pos);
+    text.remove_prefix(pos == std::string_view::npos ? text.size() : pos + 1);
+    return token;
+}
+
+// The digits of a frequency such as "122.800" read as one number, like atoi would once the
+// dots are removed. Too many digits to be a frequency in kHz give 0 rather than overflowing.
+int ParseFrequencyDigits(std::string_view text)
+{
+    constexpr int kMaxValue = std::numeric_limits<int>::max() / 1000;
+    int value = 0;
+    for (char c : text) {
+        if (c == '.') {
+            continue;
+        }
+        if (c < '0' || c > '9') {
+            break;
+        }
+        if (value > (kMaxValue - (c - '0')) / 10) {
+            return 0;
+        }
+        value = value * 10 + (c - '0');
+    }
+    return value;
+}
+
+// Parses a coordinate like std::stod, without allocating. Floating point std::from_chars is not
+// available on every standard library we build with.
+double ParseCoordinate(std::string_view text)
+{
+    std::array<char, 32> buffer {};
+    auto length = std::min(text.size(), buffer.size() - 1);
+    std::copy_n(text.begin(), length, buffer.begin());
+
+    char* end = nullptr;
+    double value = std::strtod(buffer.data(), &end);
+    if (end == buffer.data()) {
+        throw std::invalid_argument("Invalid coordinate: " + std::string(text));
+    }
+    return value;
+}
+} // namespace
+
+std::optional<SlurperConnection> SlurperParser::parse(std::string_view data)
+{
+    if (data.empty()) {
+        return std::nullopt;
+    }
+
+    // The first ATC connection is used, otherwise the first connection that is not a pilot
+    std::optional<ConnectionInfo> atcConnection;
+    std::optional<ConnectionInfo> otherConnection;
+
+    std::string_view remaining = data;
+    while (!remaining.empty() && !atcConnection) {
+        std::string_view line = NextToken(remaining, '\n');
+        if (line.empty()) {
+            continue;
+        }
+
+        std::array<std::string_view, 7> fields;
+        auto separators = std::count(line.begin(), line.end(), ',');
+        if (separators < static_cast<std::ptrdiff_t>(fields.size()) - 1) {
+            continue;
+        }
+        for (auto& field : fields) {
+            field = NextToken(line, ',');
+        }
+
+        if (endsWith(fields[2], "_ATIS")) {
+            continue;
+        }
+
+        if (fields[2] == "DCLIENT3") {
+            continue;
+        }
+
+        bool isPilot = fields[3] == "pilot";
+        auto type = getPyx_00z(isPilot, fields[1]);
+        ConnectionInfo connection { fields[1], fields[3], fields[2], fields[5], fields[6] };
+        if (type == ConnectionType::z1) {
+            atcConnection = connection;
+        } else if (type == ConnectionType::op && !otherConnection) {
+            otherConnection = connection;
+        }
+    }
+
+    if (!atcConnection && !otherConnection) {
+        return std::nullopt;
+    }
+
+    const bool isAtc = atcConnection.has_value();
+    const auto& connection = isAtc ? *atcConnection : *otherConnection;
+
+    SlurperConnection result;
+    result.callsign = connection.callsign;
+    // NOLINTNEXTLINE
+    result.frequency = ParseFrequencyDigits(connection.res3) * 1000;
+    result.isAtc = isAtc;
+    result.lat = ParseCoordinate(connection.lat);
+    result.lon = ParseCoordinate(connection.lon);
+    return result;
+}
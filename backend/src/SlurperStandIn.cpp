@@ -0,0 +1,238 @@
+#include "SlurperStandIn.hpp"
+#include "Shared.hpp"
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_replace.h>
+#include <absl/strings/str_split.h>
+#include <absl/strings/strip.h>
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <httplib.h>
+#include <plog/Log.h>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+std::string MakeEtag(const std::string& body)
+{
+    std::stringstream etag;
+    etag << '"' << std::hex << std::hash<std::string> {}(body) << '"';
+    return etag.str();
+}
+
+int64_t ParseNumber(absl::string_view value, const std::string& what, size_t lineNumber)
+{
+    int64_t number = 0;
+    if (!absl::SimpleAtoi(value, &number) || number < 0) {
+        throw std::invalid_argument("Invalid " + what + " on line " + std::to_string(lineNumber)
+            + ": " + std::string(value));
+    }
+    return number;
+}
+}
+
+SlurperStandIn::SlurperStandIn() = default;
+
+SlurperStandIn::~SlurperStandIn() { stop(); }
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+std::vector<SlurperStandInStep> SlurperStandIn::parseScript(const std::string& script)
+{
+    std::vector<SlurperStandInStep> steps;
+    size_t lineNumber = 0;
+
+    for (absl::string_view line : absl::StrSplit(script, '\n')) {
+        lineNumber++;
+        line = absl::StripAsciiWhitespace(line);
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        std::vector<absl::string_view> tokens
+            = absl::StrSplit(line, absl::MaxSplits(' ', 2), absl::SkipWhitespace());
+        if (tokens.size() < 2) {
+            throw std::invalid_argument("Missing step on line " + std::to_string(lineNumber));
+        }
+
+        SlurperStandInStep step;
+        step.offset = std::chrono::milliseconds(ParseNumber(tokens[0], "offset", lineNumber));
+        absl::string_view argument
+            = tokens.size() > 2 ? absl::StripAsciiWhitespace(tokens[2]) : absl::string_view();
+
+        if (tokens[1] == "Body") {
+            step.type = SlurperStandInStepType::kBody;
+            step.text = absl::StrReplaceAll(argument, { { "\\n", "\n" } });
+        } else if (tokens[1] == "Status") {
+            step.type = SlurperStandInStepType::kStatus;
+            step.status = static_cast<int>(ParseNumber(argument, "status", lineNumber));
+        } else if (tokens[1] == "Delay") {
+            step.type = SlurperStandInStepType::kDelay;
+            step.delay = std::chrono::milliseconds(ParseNumber(argument, "delay", lineNumber));
+        } else if (tokens[1] == "Version") {
+            step.type = SlurperStandInStepType::kVersion;
+            step.text = std::string(argument);
+        } else {
+            throw std::invalid_argument("Unknown step on line " + std::to_string(lineNumber) + ": "
+                + std::string(tokens[1]));
+        }
+
+        steps.push_back(std::move(step));
+    }
+
+    std::stable_sort(steps.begin(), steps.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.offset < rhs.offset; });
+    return steps;
+}
+
+std::vector<SlurperStandInStep> SlurperStandIn::loadScript(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    if (!file) {
+        throw std::invalid_argument("Cannot open slurper script " + path.string());
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parseScript(buffer.str());
+}
+
+std::string SlurperStandIn::start(std::vector<SlurperStandInStep> newTimeline)
+{
+    stop();
+
+    size_t stepCount = newTimeline.size();
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopRequested = false;
+        timeline = std::move(newTimeline);
+        requestLog.clear();
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    server = std::make_unique<httplib::Server>();
+    server->Get(SLURPER_DATA_ENDPOINT,
+        [this](const httplib::Request& req, httplib::Response& res) { handleSlurper(req, res); });
+    server->Get(VERSION_CHECK_ENDPOINT,
+        [this](const httplib::Request& req, httplib::Response& res) { handleVersion(req, res); });
+
+    int port = server->bind_to_any_port("127.0.0.1");
+    if (port <= 0) {
+        server.reset();
+        throw std::runtime_error("Cannot bind the slurper stand-in to a local port");
+    }
+    worker = std::thread([this]() { server->listen_after_bind(); });
+
+    auto baseUrl = "http://127.0.0.1:" + std::to_string(port);
+    PLOGI << "Slurper stand-in serving " << stepCount << " steps at " << baseUrl;
+    return baseUrl;
+}
+
+void SlurperStandIn::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopRequested = true;
+    }
+    cv.notify_all();
+
+    if (server) {
+        server->stop();
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+    server.reset();
+}
+
+std::vector<SlurperStandInRequest> SlurperStandIn::requests() const
+{
+    std::lock_guard<std::mutex> lock(m);
+    return requestLog;
+}
+
+void SlurperStandIn::handleSlurper(const httplib::Request& req, httplib::Response& res)
+{
+    auto offset = elapsed();
+    auto state = stateAt(offset);
+    if (!waitFor(state.delay)) {
+        res.status = 503;
+        return;
+    }
+
+    auto etag = MakeEtag(state.body);
+    if (state.status != 200) {
+        res.status = state.status;
+    } else if (req.get_header_value("If-None-Match") == etag) {
+        res.status = 304;
+        res.set_header("ETag", etag);
+    } else {
+        res.status = 200;
+        res.set_header("ETag", etag);
+        res.set_content(state.body, "text/plain");
+    }
+    logRequest(offset, req.path, res.status);
+}
+
+void SlurperStandIn::handleVersion(const httplib::Request& req, httplib::Response& res)
+{
+    auto offset = elapsed();
+    auto state = stateAt(offset);
+    if (!waitFor(state.delay)) {
+        res.status = 503;
+        return;
+    }
+
+    res.status = 200;
+    res.set_content(state.version.value_or(VERSION.to_string()), "text/plain");
+    logRequest(offset, req.path, res.status);
+}
+
+SlurperStandIn::ResponseState SlurperStandIn::stateAt(std::chrono::milliseconds offset) const
+{
+    std::lock_guard<std::mutex> lock(m);
+    ResponseState state;
+    for (const auto& step : timeline) {
+        if (step.offset > offset) {
+            break;
+        }
+
+        switch (step.type) {
+        case SlurperStandInStepType::kBody:
+            state.status = 200;
+            state.body = step.text;
+            break;
+        case SlurperStandInStepType::kStatus:
+            state.status = step.status;
+            break;
+        case SlurperStandInStepType::kDelay:
+            state.delay = step.delay;
+            break;
+        case SlurperStandInStepType::kVersion:
+            state.version = step.text;
+            break;
+        }
+    }
+    return state;
+}
+
+std::chrono::milliseconds SlurperStandIn::elapsed() const
+{
+    std::lock_guard<std::mutex> lock(m);
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+}
+
+bool SlurperStandIn::waitFor(std::chrono::milliseconds delay)
+{
+    std::unique_lock<std::mutex> lock(m);
+    if (delay.count() > 0) {
+        cv.wait_for(lock, delay, [this] { return stopRequested; });
+    }
+    return !stopRequested;
+}
+
+void SlurperStandIn::logRequest(
+    std::chrono::milliseconds offset, const std::string& path, int status)
+{
+    std::lock_guard<std::mutex> lock(m);
+    requestLog.push_back({ offset, path, status });
+}
@@ -0,0 +1,152 @@
+#include "StartupProfiler.hpp"
+#include "Shared.hpp"
+#include <fstream>
+#include <plog/Log.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+StartupProfiler::Phase::Phase(std::string name)
+    : name(std::move(name))
+    , wallStart(std::chrono::steady_clock::now())
+    , cpuStartMs(processCpuMs())
+{
+}
+
+StartupProfiler::Phase::~Phase()
+{
+    auto wallEnd = std::chrono::steady_clock::now();
+    StartupPhaseTiming timing;
+    timing.name = std::move(name);
+    timing.startMs = msSinceLoad(wallStart);
+    timing.wallMs = std::chrono::duration<double, std::milli>(wallEnd - wallStart).count();
+    timing.cpuMs = processCpuMs() - cpuStartMs;
+    record(std::move(timing));
+}
+
+void StartupProfiler::record(StartupPhaseTiming&& timing)
+{
+    std::lock_guard<std::mutex> lock(m);
+    if (finished) {
+        return;
+    }
+    phases.push_back(std::move(timing));
+}
+
+void StartupProfiler::finish()
+{
+    auto path = reportPath();
+    nlohmann::json latest;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if (finished) {
+            return;
+        }
+        finished = true;
+        latest = currentReport();
+    }
+
+    for (const auto& phase : latest["phases"]) {
+        PLOGI << "Startup phase " << phase["name"].get<std::string>() << ": "
+              << phase["wallMs"].get<double>() << " ms wall, " << phase["cpuMs"].get<double>()
+              << " ms CPU";
+    }
+
+    // Keep the reports of previous runs, most recent first
+    auto previousHistory = nlohmann::json::array();
+    try {
+        std::ifstream in(path);
+        if (in) {
+            auto previous = nlohmann::json::parse(in);
+            if (previous.contains("latest")) {
+                previousHistory.push_back(previous["latest"]);
+            }
+            if (previous.contains("history") && previous["history"].is_array()) {
+                for (const auto& entry : previous["history"]) {
+                    if (previousHistory.size() >= kMaxHistory) {
+                        break;
+                    }
+                    previousHistory.push_back(entry);
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        PLOGW << "Ignoring unreadable startup report: " << e.what();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m);
+        history = previousHistory;
+    }
+
+    std::ofstream out(path, std::ios::trunc);
+    out << nlohmann::json { { "latest", latest }, { "history", previousHistory } }.dump(2);
+    if (!out) {
+        PLOGW << "Could not write startup report to " << path;
+    }
+}
+
+nlohmann::json StartupProfiler::report()
+{
+    std::lock_guard<std::mutex> lock(m);
+    return { { "latest", currentReport() }, { "history", history } };
+}
+
+nlohmann::json StartupProfiler::currentReport()
+{
+    auto phaseList = nlohmann::json::array();
+    for (const auto& phase : phases) {
+        phaseList.push_back({ { "name", phase.name }, { "startMs", phase.startMs },
+            { "wallMs", phase.wallMs }, { "cpuMs", phase.cpuMs } });
+    }
+
+    auto now = std::chrono::system_clock::now();
+    return { { "version", VERSION.to_string() },
+        { "timestamp",
+            std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count() },
+        { "finished", finished },
+        { "sinceLoadMs", msSinceLoad(std::chrono::steady_clock::now()) },
+        { "phases", phaseList } };
+}
+
+std::string StartupProfiler::reportPath()
+{
+    return (FileSystem::GetStateFolderPath() / "startup_report.json").string();
+}
+
+double StartupProfiler::msSinceLoad(std::chrono::steady_clock::time_point timePoint)
+{
+    return std::chrono::duration<double, std::milli>(timePoint - loadTime).count();
+}
+
+double StartupProfiler::processCpuMs()
+{
+#ifdef _WIN32
+    FILETIME creationTime;
+    FILETIME exitTime;
+    FILETIME kernelTime;
+    FILETIME userTime;
+    if (GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)
+        == 0) {
+        return 0;
+    }
+    auto toHundredNs = [](const FILETIME& time) {
+        return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    return static_cast<double>(toHundredNs(kernelTime) + toHundredNs(userTime)) / 10000.0;
+#else
+    rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    auto toMs = [](const timeval& time) {
+        return static_cast<double>(time.tv_sec) * 1000.0
+            + static_cast<double>(time.tv_usec) / 1000.0;
+    };
+    return toMs(usage.ru_utime) + toMs(usage.ru_stime);
+#endif
+}
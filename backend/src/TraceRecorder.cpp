@@ -0,0 +1,172 @@
+#include "TraceRecorder.hpp"
+#include "Shared.hpp"
+#include <plog/Log.h>
+
+bool TraceRecorder::start(const std::filesystem::path& path)
+{
+    stop();
+
+    std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex);
+
+    std::error_code err;
+    std::filesystem::create_directories(path.parent_path(), err);
+
+    auto file = std::make_unique<std::ofstream>(path, std::ios::binary | std::ios::trunc);
+    if (!file->is_open()) {
+        PLOGE << "Could not create trace file " << path.string();
+        return false;
+    }
+
+    auto wallClockStartMs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    uint32_t reserved = 0;
+    file->write(trace::kMagic.data(), trace::kMagic.size());
+    file->write(reinterpret_cast<const char*>(&trace::kVersion), sizeof(trace::kVersion));
+    file->write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+    file->write(reinterpret_cast<const char*>(&wallClockStartMs), sizeof(wallClockStartMs));
+
+    if (!ring) {
+        ring = std::make_unique<BoundedMpmcQueue<trace::Record>>(kRingCapacity);
+    }
+
+    // Discard records that late producers pushed after the previous recording stopped
+    trace::Record discarded;
+    while (ring->tryPop(discarded)) { }
+
+    traceFile = std::move(file);
+    dropped = 0;
+    startTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+                      .count();
+    {
+        std::lock_guard<std::mutex> writerLock(writerMutex);
+        writerStopRequested = false;
+    }
+    writerThread = std::make_unique<std::thread>(&TraceRecorder::writerLoop, traceFile.get());
+    recording.store(true, std::memory_order_release);
+
+    PLOGI << "Recording trace to " << path.string();
+    return true;
+}
+
+void TraceRecorder::stop()
+{
+    std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex);
+    if (!writerThread) {
+        return;
+    }
+
+    recording.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> writerLock(writerMutex);
+        writerStopRequested = true;
+    }
+    writerCv.notify_all();
+
+    if (writerThread->joinable()) {
+        writerThread->join();
+    }
+    writerThread.reset();
+    traceFile.reset();
+
+    PLOGI << "Trace recording stopped, " << dropped.load() << " records dropped";
+}
+
+void TraceRecorder::recordAfvEvent(AfvScriptedEventType type, unsigned int frequency,
+    std::string_view callsign, const std::vector<std::string>& activeTransmitters,
+    std::string_view name)
+{
+    if (!isRecording()) {
+        return;
+    }
+
+    trace::Record record;
+    record.kind = trace::RecordKind::kAfvEvent;
+    record.code = static_cast<uint8_t>(type);
+
+    trace::PayloadWriter writer(record);
+    writer.writeU32(frequency);
+    writer.writeString(callsign);
+    writer.writeString(name);
+    writer.writeU32(static_cast<uint32_t>(activeTransmitters.size()));
+    for (const auto& transmitter : activeTransmitters) {
+        writer.writeString(transmitter);
+    }
+
+    push(std::move(record));
+}
+
+void TraceRecorder::recordAfvNotice(std::string_view eventName, std::string_view detail)
+{
+    recordCommand(trace::RecordKind::kAfvNotice, eventName, detail);
+}
+
+void TraceRecorder::recordCommand(
+    trace::RecordKind kind, std::string_view name, std::string_view arguments)
+{
+    if (!isRecording()) {
+        return;
+    }
+
+    trace::Record record;
+    record.kind = kind;
+
+    trace::PayloadWriter writer(record);
+    writer.writeString(name);
+    writer.writeString(arguments);
+
+    push(std::move(record));
+}
+
+std::filesystem::path TraceRecorder::defaultTracePath()
+{
+    auto now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch())
+                   .count();
+    return FileSystem::GetStateFolderPath() / "traces"
+        / ("trace-" + std::to_string(now) + ".tatrace");
+}
+
+void TraceRecorder::push(trace::Record&& record)
+{
+    record.timestampNs = elapsedNs();
+    if (!ring->tryPush(std::move(record))) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+uint64_t TraceRecorder::elapsedNs()
+{
+    auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+                     .count();
+    return static_cast<uint64_t>(std::max<int64_t>(0, nowNs - startTimeNs.load()));
+}
+
+void TraceRecorder::writerLoop(std::ofstream* file)
+{
+    trace::Record record;
+    bool stopRequested = false;
+
+    while (!stopRequested) {
+        {
+            std::unique_lock<std::mutex> lock(writerMutex);
+            stopRequested
+                = writerCv.wait_for(lock, kWriterInterval, [] { return writerStopRequested; });
+        }
+
+        // Drain after the stop request too, so records pushed before stop() are kept
+        while (ring->tryPop(record)) {
+            auto kind = static_cast<uint8_t>(record.kind);
+            file->write(
+                reinterpret_cast<const char*>(&record.timestampNs), sizeof(record.timestampNs));
+            file->write(reinterpret_cast<const char*>(&kind), sizeof(kind));
+            file->write(reinterpret_cast<const char*>(&record.code), sizeof(record.code));
+            file->write(reinterpret_cast<const char*>(&record.length), sizeof(record.length));
+            file->write(record.payload.data(), record.length);
+        }
+        file->flush();
+    }
+}
@@ -0,0 +1,209 @@
+#include "TraceReplayer.hpp"
+#include <cstring>
+#include <plog/Log.h>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    size = static_cast<size_t>(std::filesystem::file_size(path));
+    if (size == 0) {
+        throw std::runtime_error("File is empty: " + path.string());
+    }
+
+#ifdef _WIN32
+    fileHandle = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open " + path.string());
+    }
+    mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle == nullptr) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot map " + path.string());
+    }
+    address = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (address == nullptr) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot map " + path.string());
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path.string());
+    }
+    address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        address = nullptr;
+        throw std::runtime_error("Cannot map " + path.string());
+    }
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    if (address != nullptr) {
+        UnmapViewOfFile(address);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != nullptr && fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+    }
+#else
+    if (address != nullptr) {
+        munmap(address, size);
+    }
+#endif
+}
+
+TraceReplayer::TraceReplayer(SdkCommandSink sdkCommandSink)
+    : sdkCommandSink(std::move(sdkCommandSink))
+{
+}
+
+TraceReplayer::~TraceReplayer() { stop(); }
+
+void TraceReplayer::start(const std::filesystem::path& path, double speed)
+{
+    auto file = std::make_shared<MappedFile>(path);
+    auto data = file->data();
+    if (data.size() < trace::kFileHeaderSize
+        || std::memcmp(data.data(), trace::kMagic.data(), trace::kMagic.size()) != 0) {
+        throw std::runtime_error("Not a TrackAudio trace: " + path.string());
+    }
+
+    uint32_t version = 0;
+    std::memcpy(&version, data.data() + trace::kMagic.size(), sizeof(version));
+    if (version != trace::kVersion) {
+        throw std::runtime_error("Unsupported trace version " + std::to_string(version));
+    }
+
+    stop();
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopRequested = false;
+    }
+    running = true;
+    worker = std::thread(&TraceReplayer::run, this, std::move(file), speed);
+}
+
+void TraceReplayer::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopRequested = true;
+    }
+    cv.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+    running = false;
+}
+
+AfvScriptedEvent TraceReplayer::decodeAfvEvent(uint8_t code, std::string_view payload)
+{
+    trace::PayloadReader reader(payload);
+
+    AfvScriptedEvent event;
+    event.type = static_cast<AfvScriptedEventType>(code);
+    event.frequency = reader.readU32();
+    event.callsign = std::string(reader.readString());
+    event.name = std::string(reader.readString());
+    auto transmitterCount = reader.readU32();
+    for (uint32_t i = 0; i < transmitterCount; i++) {
+        auto transmitter = reader.readString();
+        if (transmitter.empty()) {
+            break;
+        }
+        event.activeTransmitters.emplace_back(transmitter);
+    }
+    return event;
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+void TraceReplayer::run(std::shared_ptr<MappedFile> file, double speed)
+{
+    auto data = file->data();
+    size_t offset = trace::kFileHeaderSize;
+    size_t replayed = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    PLOGI << "Replaying trace (" << data.size() << " bytes) at speed " << speed;
+
+    while (offset + trace::kRecordHeaderSize <= data.size()) {
+        uint64_t timestampNs = 0;
+        uint8_t kind = 0;
+        uint8_t code = 0;
+        uint16_t length = 0;
+        const char* header = data.data() + offset;
+        std::memcpy(&timestampNs, header, sizeof(timestampNs));
+        std::memcpy(&kind, header + 8, sizeof(kind));
+        std::memcpy(&code, header + 9, sizeof(code));
+        std::memcpy(&length, header + 10, sizeof(length));
+        offset += trace::kRecordHeaderSize;
+
+        if (offset + length > data.size()) {
+            PLOGW << "Trace is truncated, stopping replay";
+            break;
+        }
+        auto payload = data.substr(offset, length);
+        offset += length;
+
+        {
+            std::unique_lock<std::mutex> lock(m);
+            if (speed > 0) {
+                auto due = startTime
+                    + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::nanoseconds(timestampNs) / speed);
+                if (cv.wait_until(lock, due, [this] { return stopRequested; })) {
+                    break;
+                }
+            } else if (stopRequested) {
+                break;
+            }
+        }
+
+        switch (static_cast<trace::RecordKind>(kind)) {
+        case trace::RecordKind::kAfvEvent:
+            AfvEventInjector::fire(decodeAfvEvent(code, payload));
+            break;
+        case trace::RecordKind::kSdkCommand: {
+            trace::PayloadReader reader(payload);
+            reader.readString();
+            if (sdkCommandSink) {
+                sdkCommandSink(reader.readString());
+            }
+            break;
+        }
+        case trace::RecordKind::kNapiCall:
+        case trace::RecordKind::kAfvNotice: {
+            trace::PayloadReader reader(payload);
+            auto name = reader.readString();
+            PLOGV << "Trace replay skipping " << name << "(" << reader.readString() << ")";
+            break;
+        }
+        default:
+            PLOGW << "Unknown trace record kind " << static_cast<int>(kind);
+            break;
+        }
+        replayed++;
+    }
+
+    PLOGI << "Trace replay finished, " << replayed << " records replayed";
+    running = false;
+}
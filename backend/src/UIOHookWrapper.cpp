@@ -47,6 +47,12 @@ void UIOHookWrapper::stop()
     if (pImpl->hookThread.joinable()) {
         pImpl->hookThread.join();
     }
+
+    auto forwarded = pImpl->forwardedEvents.exchange(0);
+    auto dropped = pImpl->droppedEvents.exchange(0);
+    if (forwarded + dropped > 0) {
+        PLOGI << "libuiohook forwarded " << forwarded << " events and dropped " << dropped;
+    }
 }
 
 void UIOHookWrapper::setEventCallback(EventCallback callback)
@@ -54,13 +60,32 @@ void UIOHookWrapper::setEventCallback(EventCallback callback)
     pImpl->eventCallback = std::move(callback);
 }
 
+void UIOHookWrapper::setEventMask(EventMask mask)
+{
+    pImpl->eventMask.store(mask, std::memory_order_relaxed);
+}
+
 bool UIOHookWrapper::isRunning() const { return pImpl->running.load(); }
 
 void UIOHookWrapper::dispatchProc(uiohook_event* event, void* user_data)
 {
     auto* self = static_cast<UIOHookWrapper*>(user_data);
-    if (self && self->pImpl->eventCallback) {
-        self->pImpl->eventCallback(event);
+    if (!self) {
+        return;
+    }
+
+    // Plain load and store, the counters are only written from this thread
+    auto& impl = *self->pImpl;
+    if ((impl.eventMask.load(std::memory_order_relaxed) & eventMaskOf(event->type)) == 0) {
+        impl.droppedEvents.store(
+            impl.droppedEvents.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    impl.forwardedEvents.store(
+        impl.forwardedEvents.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (impl.eventCallback) {
+        impl.eventCallback(event);
     }
 }
 
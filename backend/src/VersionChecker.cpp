@@ -0,0 +1,188 @@
+#include "VersionChecker.hpp"
+#include "Shared.hpp"
+#include <absl/strings/ascii.h>
+#include <fstream>
+#include <httplib.h>
+#include <plog/Log.h>
+
+VersionChecker::VersionChecker()
+    : cachedVersion(readCache())
+{
+    // A cached mandatory version newer than ours cannot become older again, no need to fetch
+    if (cachedVersion) {
+        auto cached = compare(*cachedVersion, true);
+        if (cached.state == VersionCheckState::kUpdateRequired) {
+            currentResult = std::move(cached);
+        }
+    }
+}
+
+VersionChecker::~VersionChecker() { stop(); }
+
+void VersionChecker::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopRequested = true;
+        if (activeClient) {
+            activeClient->stop();
+        }
+    }
+    cv.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void VersionChecker::start()
+{
+    std::lock_guard<std::mutex> lock(m);
+    if (running || stopRequested
+        || (currentResult.state != VersionCheckState::kPending
+            && currentResult.state != VersionCheckState::kFailed && !currentResult.fromCache)) {
+        return;
+    }
+
+    // The previous worker has finished once running is false
+    if (worker.joinable()) {
+        worker.join();
+    }
+    running = true;
+    worker = std::thread(&VersionChecker::run, this);
+}
+
+VersionCheckResult VersionChecker::result()
+{
+    std::lock_guard<std::mutex> lock(m);
+    return currentResult;
+}
+
+VersionCheckResult VersionChecker::awaitResult(std::chrono::milliseconds timeout)
+{
+    if (result().state == VersionCheckState::kFailed) {
+        start();
+    }
+
+    std::unique_lock<std::mutex> lock(m);
+    cv.wait_for(lock, timeout, [this] { return !running || stopRequested; });
+    return currentResult;
+}
+
+void VersionChecker::run()
+{
+    auto startTime = std::chrono::steady_clock::now();
+    auto client = std::make_shared<httplib::Client>(RemoteEndpoints::getVersionCheckBaseUrl());
+    client->set_connection_timeout(10);
+    client->set_read_timeout(10);
+    {
+        std::lock_guard<std::mutex> lock(m);
+        activeClient = client;
+    }
+
+    VersionCheckResult newResult;
+    try {
+        auto res = client->Get(VERSION_CHECK_ENDPOINT);
+        if (!res || res->status != httplib::StatusCode::OK_200) {
+            PLOGE << "Error fetching version: "
+                  << (res ? "HTTP error " + std::to_string(res->status)
+                          : "Unable to reach server at all or no internet connection");
+            newResult.state = VersionCheckState::kFailed;
+        } else {
+            std::string cleanBody = res->body;
+            absl::StripAsciiWhitespace(&cleanBody);
+            newResult = compare(cleanBody, false);
+            if (newResult.state != VersionCheckState::kFailed) {
+                writeCache(cleanBody);
+            }
+        }
+    } catch (const std::exception& e) {
+        PLOGE << "Error fetching version: " << e.what();
+        newResult.state = VersionCheckState::kFailed;
+    }
+
+    if (newResult.state == VersionCheckState::kFailed && cachedVersion) {
+        PLOGW << "Version check failed, falling back to cached mandatory version "
+              << *cachedVersion;
+        newResult = compare(*cachedVersion, true);
+    }
+
+    PLOGI << "Version check finished in "
+          << std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::steady_clock::now() - startTime)
+                 .count()
+          << " ms";
+    finish(std::move(newResult));
+}
+
+void VersionChecker::finish(VersionCheckResult&& newResult)
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if (newResult.state == VersionCheckState::kUpdateRequired) {
+            PLOGE << "Mandatory update required: " << VERSION.to_string() << " -> "
+                  << newResult.mandatoryVersion;
+        }
+        currentResult = std::move(newResult);
+        activeClient.reset();
+        running = false;
+    }
+    cv.notify_all();
+}
+
+std::filesystem::path VersionChecker::cachePath()
+{
+    return FileSystem::GetStateFolderPath() / "mandatory_version";
+}
+
+std::optional<std::string> VersionChecker::readCache()
+{
+    std::ifstream file(cachePath());
+    std::string version;
+    if (!file || !std::getline(file, version)) {
+        return std::nullopt;
+    }
+    absl::StripAsciiWhitespace(&version);
+    if (version.empty()) {
+        return std::nullopt;
+    }
+    return version;
+}
+
+void VersionChecker::writeCache(const std::string& mandatoryVersion)
+{
+    // Write to a temporary file first so a crash never leaves a truncated cache behind
+    auto path = cachePath();
+    auto tempPath = path;
+    tempPath += ".tmp";
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!(file << mandatoryVersion << '\n')) {
+            PLOGW << "Could not write mandatory version cache " << tempPath.string();
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        PLOGW << "Could not write mandatory version cache: " << ec.message();
+    }
+}
+
+VersionCheckResult VersionChecker::compare(const std::string& mandatoryVersion, bool fromCache)
+{
+    VersionCheckResult result;
+    result.fromCache = fromCache;
+    result.mandatoryVersion = mandatoryVersion;
+    try {
+        result.state = VERSION < semver::version(mandatoryVersion)
+            ? VersionCheckState::kUpdateRequired
+            : VersionCheckState::kUpToDate;
+    } catch (const std::exception& e) {
+        PLOGE << "Error parsing version " << mandatoryVersion << ": " << e.what();
+        result.state = VersionCheckState::kFailed;
+    }
+    return result;
+}
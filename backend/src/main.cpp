@@ -7,6 +7,7 @@
 #include "afv-native/hardwareType.h"
 #include <absl/strings/ascii.h>
 #include <absl/strings/match.h>
+#include <absl/strings/str_join.h>
 #include <atomic>
 #include <cctype>
 #include <chrono>
@@ -18,16 +19,29 @@
 #include <plog/Log.h>
 #include <sago/platform_folders.h>
 #include <semver.hpp>
+#include <set>
 #include <string>
 #include <thread>
 
+#include "AfvEventInjector.hpp"
+#include "AudioDeviceCatalog.hpp"
+#include "GuardUnicomTransceivers.hpp"
 #include "Helpers.hpp"
 #include "InputHandler.hpp"
+#include "PttLatency.hpp"
 #include "RadioHelper.hpp"
 #include "RemoteData.hpp"
 #include "Shared.hpp"
+#include "StartupProfiler.hpp"
+#include "TraceRecorder.hpp"
+#include "VersionChecker.hpp"
 #include "sdk.hpp"
 
+#ifdef TRACKAUDIO_FAKE_AFV
+#include "SlurperStandIn.hpp"
+#include "TraceReplayer.hpp"
+#endif
+
 using namespace afv_native::event;
 
 struct MainThreadShared {
@@ -35,155 +49,278 @@ public:
     inline static std::unique_ptr<RemoteData> mRemoteDataHandler = nullptr;
     inline static std::shared_ptr<SDK> mApiServer = nullptr;
 
-    inline static bool ShouldRun = true;
+    inline static std::unique_ptr<VersionChecker> versionChecker = nullptr;
+    inline static std::unique_ptr<AudioDeviceCatalog> audioDeviceCatalog = nullptr;
+    inline static std::unique_ptr<GuardUnicomTransceivers> guardUnicomTransceivers = nullptr;
 
-    inline static std::unique_ptr<std::thread> vuMeterThread = nullptr;
-    inline static std::atomic_bool runVuMeterCallback = false;
+    inline static std::atomic_bool micTestRunning = false;
+    inline static std::chrono::steady_clock::time_point micTestDeadline;
 
     inline static std::unique_ptr<InputHandler> inputHandler = nullptr;
 
+#ifdef TRACKAUDIO_FAKE_AFV
+    inline static std::unique_ptr<AfvEventInjector> eventInjector = nullptr;
+    inline static std::unique_ptr<TraceReplayer> traceReplayer = nullptr;
+    inline static std::unique_ptr<SlurperStandIn> slurperStandIn = nullptr;
+#endif
+
     inline static std::string resourcePath;
     inline static std::atomic_bool pttReleaseSoundEnabled = false;
+
+    // Serializes the blocking audio and network operations on mClient, whether they run on the JS
+    // thread or in an async worker
+    inline static std::mutex clientOperationMutex;
 };
 namespace {
-Napi::Array GetAudioApis(const Napi::CallbackInfo& info)
+AudioDeviceCatalogSource CreateAudioDeviceCatalogSource()
+{
+    AudioDeviceCatalogSource source;
+    source.listApis = []() {
+        std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
+        return mClient ? mClient->GetAudioApis() : std::map<unsigned int, std::string> {};
+    };
+    source.listDevices = [](unsigned int apiId, bool isInput) {
+        std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
+        if (!mClient) {
+            return std::vector<AudioDeviceInfo> {};
+        }
+        return isInput ? mClient->GetAudioInputDevices(apiId)
+                       : mClient->GetAudioOutputDevices(apiId);
+    };
+    source.isBusy = []() {
+        std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
+        return mClient && mClient->IsAudioRunning();
+    };
+    return source;
+}
+
+nlohmann::json AudioDeviceListToJson(const AudioDeviceList& list)
+{
+    auto devices = nlohmann::json::array();
+    for (const auto& [deviceId, deviceName, isDefault] : list.devices) {
+        devices.push_back(
+            { { "id", deviceId }, { "name", deviceName }, { "isDefault", isDefault } });
+    }
+    return { { "devices", devices }, { "refreshing", list.refreshing } };
+}
+
+Napi::Object GetAudioApis(const Napi::CallbackInfo& info)
 {
     Napi::Env env = info.Env();
+    Napi::Object result = Napi::Object::New(env);
     Napi::Array arr = Napi::Array::New(env);
-    if (!mClient) {
-        return arr;
+    result.Set("apis", arr);
+    result.Set("refreshing", false);
+    if (!MainThreadShared::audioDeviceCatalog) {
+        return result;
     }
 
-    for (const auto& [apiId, apiName] : mClient->GetAudioApis()) {
+    auto apiList = MainThreadShared::audioDeviceCatalog->apis();
+    for (const auto& [apiId, apiName] : apiList.apis) {
         Napi::Object obj = Napi::Object::New(env);
         obj.Set("id", apiId);
         obj.Set("name", apiName);
         arr.Set(arr.Length(), obj);
     }
+    result.Set("refreshing", apiList.refreshing);
 
-    return arr;
+    return result;
 }
 
-Napi::Array GetAudioInputDevices(const Napi::CallbackInfo& info)
+nlohmann::json ListAudioDevices(int apiId, bool isInput, std::chrono::milliseconds timeout)
 {
-    Napi::Env env = info.Env();
-    int apiId = info[0].As<Napi::Number>().Int32Value();
-    Napi::Array arr = Napi::Array::New(env);
-    if (!mClient) {
-        return arr;
+    if (!MainThreadShared::audioDeviceCatalog || apiId < 0) {
+        return AudioDeviceListToJson({});
     }
+    return AudioDeviceListToJson(MainThreadShared::audioDeviceCatalog->awaitDevices(
+        static_cast<unsigned int>(apiId), isInput, timeout));
+}
 
-    for (const auto& [deviceId, deviceName, isDefault] : mClient->GetAudioInputDevices(apiId)) {
-        Napi::Object obj = Napi::Object::New(env);
-        obj.Set("id", deviceId);
-        obj.Set("name", deviceName);
-        obj.Set("isDefault", isDefault);
-        arr.Set(arr.Length(), obj);
-    }
+Napi::Value GetAudioInputDevices(const Napi::CallbackInfo& info)
+{
+    int apiId = info[0].As<Napi::Number>().Int32Value();
+    return NapiHelpers::JsonToNapiValue(
+        info.Env(), ListAudioDevices(apiId, true, std::chrono::milliseconds(0)));
+}
 
-    return arr;
+Napi::Value GetAudioOutputDevices(const Napi::CallbackInfo& info)
+{
+    int apiId = info[0].As<Napi::Number>().Int32Value();
+    return NapiHelpers::JsonToNapiValue(
+        info.Env(), ListAudioDevices(apiId, false, std::chrono::milliseconds(0)));
 }
 
-Napi::Array GetAudioOutputDevices(const Napi::CallbackInfo& info)
+// The async variants wait for a list that has not been enumerated yet
+constexpr auto kAudioDeviceEnumerationTimeout = std::chrono::seconds(10);
+
+Napi::Promise GetAudioInputDevicesAsync(const Napi::CallbackInfo& info)
 {
-    Napi::Env env = info.Env();
     int apiId = info[0].As<Napi::Number>().Int32Value();
-    Napi::Array arr = Napi::Array::New(env);
-    if (!mClient) {
-        return arr;
-    }
+    return NapiHelpers::HandleSimplePromise<nlohmann::json>(
+        info.Env(), "audio-input-devices", [apiId]() {
+            return ListAudioDevices(apiId, true, kAudioDeviceEnumerationTimeout);
+        });
+}
 
-    for (const auto& [deviceId, deviceName, isDefault] : mClient->GetAudioOutputDevices(apiId)) {
-        Napi::Object obj = Napi::Object::New(env);
-        obj.Set("id", deviceId);
-        obj.Set("name", deviceName);
-        obj.Set("isDefault", isDefault);
-        arr.Set(arr.Length(), obj);
+Napi::Promise GetAudioOutputDevicesAsync(const Napi::CallbackInfo& info)
+{
+    int apiId = info[0].As<Napi::Number>().Int32Value();
+    return NapiHelpers::HandleSimplePromise<nlohmann::json>(
+        info.Env(), "audio-output-devices", [apiId]() {
+            return ListAudioDevices(apiId, false, kAudioDeviceEnumerationTimeout);
+        });
+}
+
+// Long enough for a fetch restarted by ConnectAsync to hit both of its timeouts
+constexpr auto kConnectVersionCheckTimeout = std::chrono::seconds(25);
+
+/**
+ * @brief Waits for the background version check, Connect is the only call gated on it.
+ *
+ * @param timeout How long to wait for a check still running, 0 to only use the current result.
+ */
+bool IsVersionAllowedToConnect(std::chrono::milliseconds timeout)
+{
+    if (!MainThreadShared::versionChecker) {
+        return false;
     }
 
-    return arr;
+    auto result = MainThreadShared::versionChecker->awaitResult(timeout);
+    switch (result.state) {
+    case VersionCheckState::kUpToDate:
+        return true;
+    case VersionCheckState::kUpdateRequired:
+        NapiHelpers::sendErrorToElectron(
+            "A new mandatory version is available, please update in order to connect.");
+        return false;
+    case VersionCheckState::kPending:
+        if (timeout.count() == 0) {
+            NapiHelpers::sendErrorToElectron(
+                "The TrackAudio version is still being checked, please try again in a moment.");
+            return false;
+        }
+        [[fallthrough]];
+    case VersionCheckState::kFailed:
+    default:
+        NapiHelpers::sendErrorToElectron("Could not verify the TrackAudio version, please check "
+                                         "your internet connection and try again.");
+        return false;
+    }
 }
 
-Napi::Boolean Connect(const Napi::CallbackInfo& info)
+bool ConnectClient(const std::string& password, std::chrono::milliseconds versionCheckTimeout)
 {
-    if (!MainThreadShared::ShouldRun) {
-        return Napi::Boolean::New(info.Env(), false);
+    if (!IsVersionAllowedToConnect(versionCheckTimeout)) {
+        return false;
     }
 
-    Napi::Env env = info.Env();
-
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient || !UserSession::isConnectedToTheNetwork) {
-        return Napi::Boolean::New(env, false);
+        return false;
     }
 
     if (mClient->IsVoiceConnected()) {
-        return Napi::Boolean::New(info.Env(), false);
+        return false;
     }
 
     if (!UserAudioSetting::CheckAudioSettings()) {
         NapiHelpers::sendErrorToElectron(
             "Audio settings not set, please set all your audio devices correctly (Speakers, "
             "Microphone, Headset and API)");
-        return Napi::Boolean::New(env, false);
+        return false;
     }
 
-    auto password = info[0].As<Napi::String>().Utf8Value();
-
     {
         std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
         mClient->SetCallsign(UserSession::callsign);
         mClient->SetCredentials(UserSession::cid, password);
         mClient->SetClientPosition(UserSession::lat, UserSession::lon, 150, 150);
     }
-    return Napi::Boolean::New(env, mClient->Connect());
+    return mClient->Connect();
+}
+
+/**
+ * @brief Has the slurper polled right away and faster for a while, as the session is about to
+ * be looked up or checked.
+ */
+void PollSessionSoon()
+{
+    if (MainThreadShared::mRemoteDataHandler) {
+        MainThreadShared::mRemoteDataHandler->pollSoon();
+    }
+}
+
+/**
+ * @brief Connects on the main thread without waiting for a version check still running, use
+ * ConnectAsync to wait for it.
+ */
+Napi::Boolean Connect(const Napi::CallbackInfo& info)
+{
+    auto password = info[0].As<Napi::String>().Utf8Value();
+    PollSessionSoon();
+    return Napi::Boolean::New(info.Env(), ConnectClient(password, std::chrono::milliseconds(0)));
+}
+
+Napi::Promise ConnectAsync(const Napi::CallbackInfo& info)
+{
+    auto password = info[0].As<Napi::String>().Utf8Value();
+    PollSessionSoon();
+    return NapiHelpers::HandleSimplePromise<nlohmann::json>(info.Env(), "connect", [password]() {
+        return nlohmann::json(ConnectClient(password, kConnectVersionCheckTimeout));
+    });
 }
 
 void Disconnect(const Napi::CallbackInfo& /*info*/)
 {
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient || !mClient->IsVoiceConnected()) {
         return;
     }
     mClient->Disconnect();
+    if (MainThreadShared::guardUnicomTransceivers) {
+        MainThreadShared::guardUnicomTransceivers->invalidate();
+    }
     MainThreadShared::mApiServer->handleAFVEventForWebsocket(
         sdk::types::Event::kDisconnectFrequencyStateUpdate, {}, {});
 }
 
-void SetGuardAndUnicomTransceivers()
+GuardUnicomTransceiverSource CreateGuardUnicomTransceiverSource()
 {
-    if (!mClient) {
-        return;
-    }
-    const auto transceivers = mClient->GetTransceivers();
-    const auto states = mClient->getRadioState();
-
-    std::vector<afv_native::afv::dto::StationTransceiver> guardAndUnicomTransceivers;
-    for (const auto& [frequency, state] : states) {
-        if (frequency == UNICOM_FREQUENCY || frequency == GUARD_FREQUENCY || !state.rx) {
-            continue;
+    GuardUnicomTransceiverSource source;
+    source.listRxStations = []() {
+        std::set<std::string> stations;
+        if (!mClient) {
+            return stations;
         }
-
-        if (transceivers.find(state.stationName) != transceivers.end()) {
-            for (const auto& transceiver : transceivers.at(state.stationName)) {
-                guardAndUnicomTransceivers.push_back(transceiver);
+        for (const auto& [frequency, state] : mClient->getRadioState()) {
+            if (frequency != UNICOM_FREQUENCY && frequency != GUARD_FREQUENCY && state.rx
+                && !state.stationName.empty()) {
+                stations.insert(state.stationName);
             }
         }
-    }
-
-    mClient->SetManualTransceivers(UNICOM_FREQUENCY, guardAndUnicomTransceivers);
-    mClient->SetManualTransceivers(GUARD_FREQUENCY, guardAndUnicomTransceivers);
-
-    PLOGV << "SetGuardAndUnicomTransceivers: " << guardAndUnicomTransceivers.size();
+        return stations;
+    };
+    source.listTransceivers = []() {
+        return mClient ? mClient->GetTransceivers()
+                       : std::map<std::string, StationTransceiverList> {};
+    };
+    source.upload = [](const StationTransceiverList& transceivers) {
+        if (!mClient) {
+            return;
+        }
+        mClient->SetManualTransceivers(UNICOM_FREQUENCY, transceivers);
+        mClient->SetManualTransceivers(GUARD_FREQUENCY, transceivers);
+    };
+    return source;
 }
 
-void SetAudioSettings(const Napi::CallbackInfo& info)
+void ApplyAudioSettings(int apiId, const std::string& inputDeviceId,
+    const std::string& headsetOutputDeviceId, const std::string& speakersOutputDeviceId)
 {
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient || mClient->IsVoiceConnected()) {
         return; // Don't allow changing audio settings while connected
     }
-    int apiId = info[0].As<Napi::Number>().Int32Value();
-    auto inputDeviceId = info[1].As<Napi::String>().Utf8Value();
-    auto headsetOutputDeviceId = info[2].As<Napi::String>().Utf8Value();
-    auto speakersOutputDeviceId = info[3].As<Napi::String>().Utf8Value();
 
     UserAudioSetting::apiId = apiId;
     UserAudioSetting::inputDeviceId = inputDeviceId;
@@ -196,20 +333,64 @@ void SetAudioSettings(const Napi::CallbackInfo& info)
     mClient->SetAudioSpeakersOutputDevice(speakersOutputDeviceId);
 }
 
-Napi::Boolean AddFrequency(const Napi::CallbackInfo& info)
+void SetAudioSettings(const Napi::CallbackInfo& info)
 {
-    if (!mClient || !mClient->IsVoiceConnected()) {
-        return Napi::Boolean::New(info.Env(), false);
-    }
+    ApplyAudioSettings(info[0].As<Napi::Number>().Int32Value(),
+        info[1].As<Napi::String>().Utf8Value(), info[2].As<Napi::String>().Utf8Value(),
+        info[3].As<Napi::String>().Utf8Value());
+}
 
-    int frequency = info[0].As<Napi::Number>().Int32Value();
-    auto callsign = info[1].As<Napi::String>().Utf8Value();
-    auto outputVolume = info.Length() > 2 ? info[2].As<Napi::Number>().FloatValue() : 100;
-    auto hasBeenAddded = mClient->AddFrequency(frequency, callsign);
+Napi::Promise SetAudioSettingsAsync(const Napi::CallbackInfo& info)
+{
+    int apiId = info[0].As<Napi::Number>().Int32Value();
+    auto inputDeviceId = info[1].As<Napi::String>().Utf8Value();
+    auto headsetOutputDeviceId = info[2].As<Napi::String>().Utf8Value();
+    auto speakersOutputDeviceId = info[3].As<Napi::String>().Utf8Value();
+
+    return NapiHelpers::HandleSimplePromise<nlohmann::json>(info.Env(), "audio-settings",
+        [apiId, inputDeviceId, headsetOutputDeviceId, speakersOutputDeviceId]() {
+            ApplyAudioSettings(
+                apiId, inputDeviceId, headsetOutputDeviceId, speakersOutputDeviceId);
+            return nlohmann::json {};
+        });
+}
+
+/**
+ * @brief Adds a frequency and applies its initial state, the caller holds clientOperationMutex.
+ */
+bool AddFrequencyWithState(
+    const RadioState& newState, const std::string& callsign, RadioStateBatch* batch = nullptr)
+{
+    auto hasBeenAddded = mClient->AddFrequency(newState.frequency, callsign);
     if (!hasBeenAddded) {
-        NapiHelpers::sendErrorToElectron("Could not add frequency: it already exists");
-        PLOGW << "Could not add frequency, it already exists: " << frequency << " " << callsign;
-        return Napi::Boolean::New(info.Env(), false);
+        PLOGW << "Could not add frequency, it already exists: " << newState.frequency << " "
+              << callsign;
+        return false;
+    }
+
+    // Issue 227: Make sure to publish the frequency was added to any connected clients.
+    MainThreadShared::mApiServer->publishStationAdded(callsign, newState.frequency);
+
+    // The new radio starts at the default gain, a volume stored for an earlier radio on this
+    // frequency would otherwise be seen as unchanged and never applied
+    RadioHelper::setRadioVolume(newState.frequency, newState.outputVolume);
+
+    auto change = RadioHelper::SetRadioState(
+        MainThreadShared::mApiServer, newState, callsign, true, batch);
+
+    // A new station is always notified, even if its initial state matches the defaults
+    if (change.applied && !change.changed()) {
+        RadioHelper::NotifyStationState(
+            MainThreadShared::mApiServer, callsign, newState.frequency, false, true, batch);
+    }
+    return change.applied;
+}
+
+bool AddClientFrequency(int frequency, const std::string& callsign, float outputVolume)
+{
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
+    if (!mClient || !mClient->IsVoiceConnected()) {
+        return false;
     }
 
     RadioState newState {};
@@ -223,15 +404,35 @@ Napi::Boolean AddFrequency(const Napi::CallbackInfo& info)
     newState.isOutputMuted = false;
     newState.outputVolume = outputVolume;
 
-    // Issue 227: Make sure to publish the frequency was added to any connected clients.
-    MainThreadShared::mApiServer->publishStationAdded(callsign, frequency);
+    if (!AddFrequencyWithState(newState, callsign)) {
+        NapiHelpers::sendErrorToElectron("Could not add frequency: it already exists");
+        return false;
+    }
+    return true;
+}
+
+Napi::Boolean AddFrequency(const Napi::CallbackInfo& info)
+{
+    int frequency = info[0].As<Napi::Number>().Int32Value();
+    auto callsign = info[1].As<Napi::String>().Utf8Value();
+    auto outputVolume = info.Length() > 2 ? info[2].As<Napi::Number>().FloatValue() : 100;
+    return Napi::Boolean::New(info.Env(), AddClientFrequency(frequency, callsign, outputVolume));
+}
 
-    auto result = RadioHelper::SetRadioState(MainThreadShared::mApiServer, newState, callsign);
-    return Napi::Boolean::New(info.Env(), result);
+Napi::Promise AddFrequencyAsync(const Napi::CallbackInfo& info)
+{
+    int frequency = info[0].As<Napi::Number>().Int32Value();
+    auto callsign = info[1].As<Napi::String>().Utf8Value();
+    auto outputVolume = info.Length() > 2 ? info[2].As<Napi::Number>().FloatValue() : 100;
+    return NapiHelpers::HandleSimplePromise<nlohmann::json>(
+        info.Env(), "add-frequency", [frequency, callsign, outputVolume]() {
+            return nlohmann::json(AddClientFrequency(frequency, callsign, outputVolume));
+        });
 }
 
 void RemoveFrequency(const Napi::CallbackInfo& info)
 {
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient) {
         return;
     }
@@ -250,19 +451,33 @@ void RemoveFrequency(const Napi::CallbackInfo& info)
     RadioHelper::SetRadioState(MainThreadShared::mApiServer, newState, callsign, false);
     mClient->RemoveFrequency(newState.frequency);
 
+    if (MainThreadShared::guardUnicomTransceivers) {
+        // A re-added GUARD or UNICOM starts without transceivers
+        if (newState.frequency == UNICOM_FREQUENCY || newState.frequency == GUARD_FREQUENCY) {
+            MainThreadShared::guardUnicomTransceivers->invalidate();
+        } else {
+            MainThreadShared::guardUnicomTransceivers->refresh();
+        }
+    }
+
     MainThreadShared::mApiServer->publishFrequencyRemoved(newState.frequency);
 }
 
 void Reset(const Napi::CallbackInfo& /*info*/)
 {
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient) {
         return;
     }
     mClient->reset();
+    if (MainThreadShared::guardUnicomTransceivers) {
+        MainThreadShared::guardUnicomTransceivers->invalidate();
+    }
 }
 
 Napi::Boolean SetFrequencyState(const Napi::CallbackInfo& info)
 {
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient) {
         return Napi::Boolean::New(info.Env(), false);
     }
@@ -279,10 +494,106 @@ Napi::Boolean SetFrequencyState(const Napi::CallbackInfo& info)
     newState.isOutputMuted = info.Length() > 7 ? info[7].As<Napi::Boolean>().Value() : false;
     newState.outputVolume = info.Length() > 8 ? info[8].As<Napi::Number>().FloatValue() : 100;
 
-    // SetGuardAndUnicomTransceivers();
+    auto change = RadioHelper::SetRadioState(MainThreadShared::mApiServer, newState, callsign);
+    return Napi::Boolean::New(info.Env(), change.applied);
+}
 
-    auto result = RadioHelper::SetRadioState(MainThreadShared::mApiServer, newState, callsign);
-    return Napi::Boolean::New(info.Env(), result);
+/**
+ * @brief Reads a { frequency, callsign, rx, tx, xc, onSpeaker, crossCoupleAcross, isOutputMuted,
+ * outputVolume } record, everything but the frequency is optional.
+ */
+RadioState ReadRadioStateRecord(const Napi::Object& record, std::string& callsign)
+{
+    auto readBool = [&record](const char* key, bool fallback) {
+        auto value = record.Get(key);
+        return value.IsBoolean() ? value.As<Napi::Boolean>().Value() : fallback;
+    };
+
+    auto callsignValue = record.Get("callsign");
+    callsign = callsignValue.IsString() ? callsignValue.As<Napi::String>().Utf8Value() : "";
+
+    RadioState state {};
+    state.frequency = record.Get("frequency").As<Napi::Number>().Int32Value();
+    state.rx = readBool("rx", false);
+    state.tx = readBool("tx", false);
+    state.xc = readBool("xc", false);
+    // Note the negation here, as the API uses the opposite of what is saved internally
+    state.headset = !readBool("onSpeaker", false);
+    state.xca = readBool("crossCoupleAcross", false);
+    state.isOutputMuted = readBool("isOutputMuted", false);
+    auto outputVolume = record.Get("outputVolume");
+    state.outputVolume
+        = outputVolume.IsNumber() ? outputVolume.As<Napi::Number>().FloatValue() : 100;
+    return state;
+}
+
+/**
+ * @brief Adds several frequencies with their initial state in one go, for restoring a position.
+ *
+ * Transceiver fetches are deduplicated and Electron gets a single station-states-update event.
+ * Returns whether each record was added.
+ */
+Napi::Array AddFrequencies(const Napi::CallbackInfo& info)
+{
+    auto env = info.Env();
+    auto records = info[0].As<Napi::Array>();
+    auto results = Napi::Array::New(env, records.Length());
+
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
+    bool isConnected = mClient && mClient->IsVoiceConnected();
+
+    RadioStateBatch batch;
+    std::vector<std::string> duplicates;
+    for (uint32_t i = 0; i < records.Length(); i++) {
+        if (!isConnected) {
+            results[i] = Napi::Boolean::New(env, false);
+            continue;
+        }
+
+        std::string callsign;
+        auto state = ReadRadioStateRecord(records.Get(i).As<Napi::Object>(), callsign);
+        if (mClient->IsFrequencyActive(state.frequency)) {
+            duplicates.push_back(callsign.empty() ? std::to_string(state.frequency) : callsign);
+            results[i] = Napi::Boolean::New(env, false);
+            continue;
+        }
+        results[i] = Napi::Boolean::New(env, AddFrequencyWithState(state, callsign, &batch));
+    }
+
+    if (isConnected) {
+        RadioHelper::FlushBatch(MainThreadShared::mApiServer, batch);
+    }
+
+    if (!duplicates.empty()) {
+        NapiHelpers::sendErrorToElectron(
+            "Could not add frequencies, they already exist: " + absl::StrJoin(duplicates, ", "));
+    }
+    return results;
+}
+
+/**
+ * @brief Sets the state of several radios in one go, see AddFrequencies.
+ */
+Napi::Array SetFrequencyStates(const Napi::CallbackInfo& info)
+{
+    auto env = info.Env();
+    auto records = info[0].As<Napi::Array>();
+    auto results = Napi::Array::New(env, records.Length());
+
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
+    RadioStateBatch batch;
+    for (uint32_t i = 0; i < records.Length(); i++) {
+        std::string callsign;
+        auto state = ReadRadioStateRecord(records.Get(i).As<Napi::Object>(), callsign);
+        auto change = RadioHelper::SetRadioState(
+            MainThreadShared::mApiServer, state, callsign, true, &batch);
+        results[i] = Napi::Boolean::New(env, change.applied);
+    }
+
+    if (mClient && MainThreadShared::mApiServer) {
+        RadioHelper::FlushBatch(MainThreadShared::mApiServer, batch);
+    }
+    return results;
 }
 
 Napi::Object GetFrequencyState(const Napi::CallbackInfo& info)
@@ -310,9 +621,24 @@ void RegisterCallback(const Napi::CallbackInfo& info)
     Napi::Env env = info.Env();
     auto callbackFunction = info[0].As<Napi::Function>();
 
-    // Create a ThreadSafeFunction
-    NapiHelpers::setCallbackRef(
-        Napi::ThreadSafeFunction::New(env, callbackFunction, "trackaudio-afv-res", 0, 3));
+    // Create a ThreadSafeFunction, bounded since events are batched by ElectronEventQueue
+    NapiHelpers::setCallbackRef(Napi::ThreadSafeFunction::New(env, callbackFunction,
+        "trackaudio-afv-res", ElectronEventQueue::kCallbackQueueSize, 3));
+}
+
+Napi::Object GetEventQueueStats(const Napi::CallbackInfo& info)
+{
+    auto env = info.Env();
+    auto stats = ElectronEventQueue::stats();
+
+    auto obj = Napi::Object::New(env);
+    obj.Set("delivered", Napi::Number::New(env, static_cast<double>(stats.delivered)));
+    obj.Set("batches", Napi::Number::New(env, static_cast<double>(stats.batches)));
+    obj.Set("coalesced", Napi::Number::New(env, static_cast<double>(stats.coalesced)));
+    obj.Set("dropped", Napi::Number::New(env, static_cast<double>(stats.dropped)));
+    obj.Set("spilled", Napi::Number::New(env, static_cast<double>(stats.spilled)));
+    obj.Set("pending", Napi::Number::New(env, static_cast<double>(stats.pending)));
+    return obj;
 }
 
 void GetStation(const Napi::CallbackInfo& info)
@@ -347,12 +673,33 @@ Napi::Boolean IsFrequencyActive(const Napi::CallbackInfo& info)
 void SetCid(const Napi::CallbackInfo& info)
 {
     auto cid = info[0].As<Napi::String>().Utf8Value();
-    std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
-    UserSession::cid = cid;
+    {
+        std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
+        UserSession::cid = cid;
+    }
+    PollSessionSoon();
+}
+
+Napi::Object GetNetworkSession(const Napi::CallbackInfo& info)
+{
+    auto env = info.Env();
+    auto session = MainThreadShared::mRemoteDataHandler
+        ? MainThreadShared::mRemoteDataHandler->currentSession()
+        : NetworkSession {};
+
+    auto obj = Napi::Object::New(env);
+    obj.Set("isConnected", Napi::Boolean::New(env, session.isConnected));
+    obj.Set("callsign", Napi::String::New(env, session.callsign));
+    obj.Set("isAtc", Napi::Boolean::New(env, session.isAtc));
+    obj.Set("frequency", Napi::Number::New(env, session.frequency));
+    obj.Set("lat", Napi::Number::New(env, session.lat));
+    obj.Set("lon", Napi::Number::New(env, session.lon));
+    return obj;
 }
 
 void SetRadioEffects(const Napi::CallbackInfo& info)
 {
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient) {
         return;
     }
@@ -383,6 +730,7 @@ void SetRadioEffects(const Napi::CallbackInfo& info)
 
 void SetHardwareType(const Napi::CallbackInfo& info)
 {
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient) {
         return;
     }
@@ -426,11 +774,7 @@ void SetMainRadioVolume(const Napi::CallbackInfo& info)
     }
     float volume = info[0].As<Napi::Number>().FloatValue();
 
-    {
-        std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
-        UserSession::currentMainVolume = volume;
-    }
-
+    UserSession::currentMainVolume.store(volume, std::memory_order_relaxed);
     RadioHelper::setAllRadioVolumes();
 
     MainThreadShared::mApiServer->publishMainVolumeChange(volume, false);
@@ -471,6 +815,7 @@ void StopAdHocSounds(const Napi::CallbackInfo& /*info*/)
 
 void SetLoopback(const Napi::CallbackInfo& info)
 {
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient) {
         return;
     }
@@ -490,9 +835,13 @@ Napi::Promise SetFrequencyRadioVolume(const Napi::CallbackInfo& info)
 
     return NapiHelpers::HandleSimplePromise<nlohmann::json>(
         env, "station-state-update", [frequency, stationVolume]() {
+            std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
+            if (!mClient) {
+                return nlohmann::json {};
+            }
             RadioHelper::setRadioVolume(frequency, stationVolume);
 
-            if (!mClient || !MainThreadShared::mApiServer) {
+            if (!MainThreadShared::mApiServer) {
                 return nlohmann::json {};
             }
 
@@ -526,67 +875,80 @@ Napi::Boolean IsConnected(const Napi::CallbackInfo& info)
 
 void StartMicTest(const Napi::CallbackInfo& /*info*/)
 {
-    if (!mClient || !NapiHelpers::callbackAvailable || MainThreadShared::vuMeterThread != nullptr) {
-        PLOGW << "Attempted to start mic test without callback or "
-                 "uninitiated client, or already running mic test, this "
-                 "will be useless";
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
+    if (!mClient || MainThreadShared::micTestRunning) {
+        PLOGW << "Attempted to start mic test with an uninitiated client, or already running mic "
+                 "test, this will be useless";
         return;
     }
 
     mClient->StartAudio();
-    MainThreadShared::runVuMeterCallback = true;
-
-    MainThreadShared::vuMeterThread = std::make_unique<std::thread>([] {
-        for (int i = 0; i < 2400; i++) { // Max of 2 minutes, don't allow infinite test
-#ifndef WIN32
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-#else
-            Sleep(50); // std::this_thread::sleep_for is boinked on windows
-#endif
-            if (!mClient || !mClient->IsAudioRunning()) {
-                break;
-            }
+    MainThreadShared::micTestDeadline = std::chrono::steady_clock::now() + std::chrono::minutes(2);
+    MainThreadShared::micTestRunning = true;
+}
 
-            if (!MainThreadShared::runVuMeterCallback) {
-                break;
-            }
+/**
+ * @brief Samples the input levels of a running mic test into a caller-owned buffer.
+ *
+ * The levels are read straight from the audio engine, so the caller decides the update rate and
+ * no thread or event is needed to push them.
+ *
+ * @param info[0] A Float32Array of at least two elements, receives the input VU and peak.
+ * @return false if no mic test is running, in which case the buffer is left untouched.
+ */
+Napi::Boolean ReadInputLevels(const Napi::CallbackInfo& info)
+{
+    auto env = info.Env();
+    auto levels = info[0].As<Napi::Float32Array>();
+    if (levels.ElementLength() < 2) {
+        throw Napi::RangeError::New(env, "ReadInputLevels needs room for two levels");
+    }
 
-            auto vuMeter = mClient->GetInputVu();
-            auto vuMeterPeak = mClient->GetInputPeak();
+    // Max of 2 minutes, don't allow infinite test
+    if (!MainThreadShared::micTestRunning || !mClient || !mClient->IsAudioRunning()
+        || std::chrono::steady_clock::now() > MainThreadShared::micTestDeadline) {
+        return Napi::Boolean::New(env, false);
+    }
 
-            NapiHelpers::callElectron(
-                "VuMeter", std::to_string(vuMeter), std::to_string(vuMeterPeak));
-        }
-    });
+    levels[0] = static_cast<float>(mClient->GetInputVu());
+    levels[1] = static_cast<float>(mClient->GetInputPeak());
+    return Napi::Boolean::New(env, true);
 }
 
 void StopMicTest(const Napi::CallbackInfo& /*info*/)
 {
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient) {
         return;
     }
 
-    MainThreadShared::runVuMeterCallback = false;
-    if (MainThreadShared::vuMeterThread && MainThreadShared::vuMeterThread->joinable()) {
-        MainThreadShared::vuMeterThread->join();
-    }
-    MainThreadShared::vuMeterThread.reset(nullptr);
-
+    MainThreadShared::micTestRunning = false;
     mClient->StopAudio();
 }
 
-void StartAudio(const Napi::CallbackInfo& /*info*/)
+bool StartClientAudio()
 {
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient || mClient->IsAudioRunning()) {
         PLOGW << "Attempted to start audio when audio already running";
-        return;
+        return false;
     }
 
     mClient->StartAudio();
+    return mClient->IsAudioRunning();
+}
+
+void StartAudio(const Napi::CallbackInfo& /*info*/) { StartClientAudio(); }
+
+Napi::Promise StartAudioAsync(const Napi::CallbackInfo& info)
+{
+    return NapiHelpers::HandleSimplePromise<nlohmann::json>(
+        info.Env(), "start-audio", []() { return nlohmann::json(StartClientAudio()); });
 }
 
 void StopAudio(const Napi::CallbackInfo& /*info*/)
 {
+    std::lock_guard<std::mutex> lock(MainThreadShared::clientOperationMutex);
     if (!mClient || !mClient->IsAudioRunning()) {
         PLOGW << "Attempted to stop audio when audio not running";
         return;
@@ -645,8 +1007,13 @@ void HandleAfvEvents()
     afv_native::event::EventBus& event = afv_native::api::getEventBus();
     registeredHandlerIds.push_back(event.AddHandler<afv_native::VoiceServerConnectedEvent>(
         [&](const afv_native::VoiceServerConnectedEvent& event) {
+            TraceRecorder::recordAfvEvent(AfvScriptedEventType::kVoiceServerConnected);
             if (NapiHelpers::_requestExit.load())
                 return;
+            // A new voice session starts with GUARD and UNICOM without transceivers
+            if (MainThreadShared::guardUnicomTransceivers) {
+                MainThreadShared::guardUnicomTransceivers->invalidate();
+            }
             NapiHelpers::callElectron("VoiceConnected");
             if (MainThreadShared::mApiServer)
                 MainThreadShared::mApiServer->handleVoiceConnectedEventForWebsocket(true);
@@ -654,6 +1021,7 @@ void HandleAfvEvents()
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::VoiceServerDisconnectedEvent>(
         [&](const afv_native::VoiceServerDisconnectedEvent& event) {
+            TraceRecorder::recordAfvEvent(AfvScriptedEventType::kVoiceServerDisconnected);
             if (NapiHelpers::_requestExit.load())
                 return;
             NapiHelpers::callElectron("VoiceDisconnected");
@@ -663,24 +1031,36 @@ void HandleAfvEvents()
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::StationTransceiversUpdatedEvent>(
         [&](const afv_native::StationTransceiversUpdatedEvent& event) {
+            TraceRecorder::recordAfvEvent(
+                AfvScriptedEventType::kStationTransceiversUpdated, 0, {}, {}, event.stationName);
             if (NapiHelpers::_requestExit.load() || !mClient)
                 return;
             std::string station = event.stationName;
             auto transceiverCount = mClient->GetTransceiverCountForStation(station);
             auto states = mClient->getRadioState();
+            bool isGuardOrUnicom = station == "GUARD" || station == "ADVISORY";
             for (const auto& state : states) {
                 if (state.second.stationName == station) {
                     mClient->UseTransceiversFromStation(station, static_cast<int>(state.first));
+                    isGuardOrUnicom = isGuardOrUnicom || state.first == UNICOM_FREQUENCY
+                        || state.first == GUARD_FREQUENCY;
                     break;
                 }
             }
-            SetGuardAndUnicomTransceivers();
-            NapiHelpers::callElectron(
-                "StationTransceiversUpdated", station, std::to_string(transceiverCount));
+            if (MainThreadShared::guardUnicomTransceivers) {
+                // The merged GUARD and UNICOM transceivers were just replaced, upload them again
+                if (isGuardOrUnicom) {
+                    MainThreadShared::guardUnicomTransceivers->invalidate();
+                } else {
+                    MainThreadShared::guardUnicomTransceivers->stationUpdated(station);
+                }
+            }
+            NapiHelpers::callElectron("StationTransceiversUpdated", station, transceiverCount);
         }));
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::StationDataReceivedEvent>(
         [&](const afv_native::StationDataReceivedEvent& event) {
+            TraceRecorder::recordAfvNotice("StationDataReceived", event.stationData.first);
             if (NapiHelpers::_requestExit.load() || !mClient)
                 return;
             if (!event.found || !event.stationData.second.has_value()) {
@@ -704,7 +1084,7 @@ void HandleAfvEvents()
             stationJson["frequency"] = station.frequency;
             stationJson["frequencyAlias"] = station.frequencyAlias;
 
-            NapiHelpers::callElectron("StationDataReceived", callsign, stationJson.dump());
+            NapiHelpers::callElectron("StationDataReceived", callsign, stationJson);
             if (MainThreadShared::mApiServer)
                 MainThreadShared::mApiServer->publishStationAdded(callsign,
                     static_cast<int>(frequency), static_cast<int>(station.frequencyAlias));
@@ -712,10 +1092,13 @@ void HandleAfvEvents()
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::VccsReceivedEvent>(
         [&](const afv_native::VccsReceivedEvent& event) {
+            TraceRecorder::recordAfvNotice("VccsReceived", std::to_string(event.vccsData.size()));
             if (NapiHelpers::_requestExit.load() || !mClient)
                 return;
             const auto& stations = event.vccsData;
 
+            // Sent as one event so the renderer adds the whole list with a single AddFrequencies
+            auto stationList = nlohmann::json::array();
             for (const auto& [callsign, station] : stations) {
 
                 const auto frequency = station.frequency;
@@ -727,19 +1110,25 @@ void HandleAfvEvents()
 
                 // Create a JSON object with the station data
                 nlohmann::json stationJson;
+                stationJson["callsign"] = callsign;
                 stationJson["name"] = station.name;
                 stationJson["frequency"] = station.frequency;
                 stationJson["frequencyAlias"] = station.frequencyAlias;
+                stationList.push_back(std::move(stationJson));
 
-                NapiHelpers::callElectron("StationDataReceived", callsign, stationJson.dump());
                 if (MainThreadShared::mApiServer)
                     MainThreadShared::mApiServer->publishStationAdded(callsign,
                         static_cast<int>(frequency), static_cast<int>(station.frequencyAlias));
             }
+
+            if (!stationList.empty()) {
+                NapiHelpers::callElectron("StationsDataReceived", stationList);
+            }
         }));
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::FrequencyRxBeginEvent>(
         [&](const afv_native::FrequencyRxBeginEvent& event) {
+            TraceRecorder::recordAfvEvent(AfvScriptedEventType::kFrequencyRxBegin, event.frequency);
             if (NapiHelpers::_requestExit.load() || !mClient)
                 return;
             if (!mClient->IsFrequencyActive(event.frequency)) {
@@ -748,11 +1137,12 @@ void HandleAfvEvents()
                 return;
             }
 
-            NapiHelpers::callElectron("FrequencyRxBegin", std::to_string(event.frequency));
+            NapiHelpers::callElectron("FrequencyRxBegin", event.frequency);
         }));
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::FrequencyRxEndEvent>(
         [&](const afv_native::FrequencyRxEndEvent& event) {
+            TraceRecorder::recordAfvEvent(AfvScriptedEventType::kFrequencyRxEnd, event.frequency);
             if (NapiHelpers::_requestExit.load() || !mClient)
                 return;
             if (!mClient->IsFrequencyActive(event.frequency)) {
@@ -760,11 +1150,13 @@ void HandleAfvEvents()
                 return;
             }
 
-            NapiHelpers::callElectron("FrequencyRxEnd", std::to_string(event.frequency));
+            NapiHelpers::callElectron("FrequencyRxEnd", event.frequency);
         }));
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::StationRxBeginEvent>(
         [&](const afv_native::StationRxBeginEvent& event) {
+            TraceRecorder::recordAfvEvent(AfvScriptedEventType::kStationRxBegin, event.frequency,
+                event.callsign, event.activeTransmitters);
             if (NapiHelpers::_requestExit.load() || !mClient)
                 return;
             if (!mClient->IsFrequencyActive(event.frequency)) {
@@ -772,8 +1164,8 @@ void HandleAfvEvents()
                 return;
             }
 
-            NapiHelpers::callElectronWithStringArray("StationRxBegin",
-                std::to_string(event.frequency), event.callsign, event.activeTransmitters);
+            NapiHelpers::callElectron(
+                "StationRxBegin", event.frequency, event.callsign, event.activeTransmitters);
             if (MainThreadShared::mApiServer)
                 MainThreadShared::mApiServer->handleAFVEventForWebsocket(
                     sdk::types::Event::kRxBegin, event.callsign, event.frequency,
@@ -782,14 +1174,16 @@ void HandleAfvEvents()
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::StationRxEndEvent>(
         [&](const afv_native::StationRxEndEvent& event) {
+            TraceRecorder::recordAfvEvent(AfvScriptedEventType::kStationRxEnd, event.frequency,
+                event.callsign, event.activeTransmitters);
             if (NapiHelpers::_requestExit.load() || !mClient)
                 return;
             if (!mClient->IsFrequencyActive(event.frequency)) {
                 PLOGW << "StationRxEnd: Frequency " << event.frequency << " not active, skipping";
                 return;
             }
-            NapiHelpers::callElectronWithStringArray("StationRxEnd",
-                std::to_string(event.frequency), event.callsign, event.activeTransmitters);
+            NapiHelpers::callElectron(
+                "StationRxEnd", event.frequency, event.callsign, event.activeTransmitters);
             if (MainThreadShared::mApiServer)
                 MainThreadShared::mApiServer->handleAFVEventForWebsocket(sdk::types::Event::kRxEnd,
                     event.callsign, event.frequency, event.activeTransmitters);
@@ -797,9 +1191,11 @@ void HandleAfvEvents()
 
     registeredHandlerIds.push_back(
         event.AddHandler<afv_native::PttOpenEvent>([&](const afv_native::PttOpenEvent& event) {
+            PttLatency::mark(PttLatencyStage::kAfvPttOpen);
+            TraceRecorder::recordAfvEvent(AfvScriptedEventType::kPttOpen);
             if (NapiHelpers::_requestExit.load())
                 return;
-            NapiHelpers::callElectron("PttState", "1");
+            NapiHelpers::callElectron("PttState", true);
             if (MainThreadShared::mApiServer)
                 MainThreadShared::mApiServer->handleAFVEventForWebsocket(
                     sdk::types::Event::kTxBegin, std::nullopt, std::nullopt);
@@ -807,9 +1203,10 @@ void HandleAfvEvents()
 
     registeredHandlerIds.push_back(
         event.AddHandler<afv_native::PttClosedEvent>([&](const afv_native::PttClosedEvent& event) {
+            TraceRecorder::recordAfvEvent(AfvScriptedEventType::kPttClosed);
             if (NapiHelpers::_requestExit.load())
                 return;
-            NapiHelpers::callElectron("PttState", "0");
+            NapiHelpers::callElectron("PttState", false);
             if (MainThreadShared::mApiServer)
                 MainThreadShared::mApiServer->handleAFVEventForWebsocket(
                     sdk::types::Event::kTxEnd, std::nullopt, std::nullopt);
@@ -826,13 +1223,19 @@ void HandleAfvEvents()
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::AudioErrorEvent>(
         [&](const afv_native::AudioErrorEvent& event) {
+            TraceRecorder::recordAfvNotice("AudioError");
             NapiHelpers::sendErrorToElectron(
                 "Error starting audio devices, check your configuration.");
         }));
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::AudioDeviceStoppedErrorEvent>(
         [&](const afv_native::AudioDeviceStoppedErrorEvent& event) {
+            TraceRecorder::recordAfvEvent(
+                AfvScriptedEventType::kAudioDeviceStoppedError, 0, {}, {}, event.deviceName);
             PLOGE << "Audio device stopped unexpectedly: " << event.deviceName;
+            if (MainThreadShared::audioDeviceCatalog) {
+                MainThreadShared::audioDeviceCatalog->invalidate();
+            }
             NapiHelpers::callElectron("AudioDeviceStopped", event.deviceName);
             NapiHelpers::sendErrorToElectron("Audio device disconnected: " + event.deviceName
                 + ". Please check your audio configuration.");
@@ -840,18 +1243,21 @@ void HandleAfvEvents()
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::VoiceServerConnectionDegradedEvent>(
         [&](const afv_native::VoiceServerConnectionDegradedEvent& event) {
+            TraceRecorder::recordAfvEvent(AfvScriptedEventType::kVoiceServerConnectionDegraded);
             PLOGW << "Voice connection quality degraded";
             NapiHelpers::callElectron("VoiceConnectionDegraded");
         }));
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::VoiceServerConnectionResumedEvent>(
         [&](const afv_native::VoiceServerConnectionResumedEvent& event) {
+            TraceRecorder::recordAfvEvent(AfvScriptedEventType::kVoiceServerConnectionResumed);
             PLOGI << "Voice connection quality resumed";
             NapiHelpers::callElectron("VoiceConnectionResumed");
         }));
 
     registeredHandlerIds.push_back(event.AddHandler<afv_native::APIServerErrorEvent>(
         [&](const afv_native::APIServerErrorEvent& event) {
+            TraceRecorder::recordAfvNotice("APIServerError", std::to_string(event.errorCode));
             auto err = static_cast<afv_native::afv::APISessionError>(event.errorCode);
 
             if (err == afv_native::afv::APISessionError::BadPassword
@@ -888,59 +1294,23 @@ Napi::String GetStateFolderNapi(const Napi::CallbackInfo& info)
     return Napi::String::New(info.Env(), FileSystem::GetStateFolderPath().string());
 }
 
-struct VersionCheckResponse {
-    VersionCheckResponse(bool succeded, bool update)
-        : success(succeded)
-        , needUpdate(update)
-    {
-    }
-    bool success = false;
-    bool needUpdate = false;
-};
-
-VersionCheckResponse CheckVersionSync()
+nlohmann::json VersionCheckResultToJson(const VersionCheckResult& result)
 {
-    // We force do a mandatory version check, if an update is needed, the
-    // programme won't run
-
-    try {
-        httplib::Client client(VERSION_CHECK_BASE_URL);
-        client.set_connection_timeout(10);
-        client.set_read_timeout(10);
-        auto res = client.Get(VERSION_CHECK_ENDPOINT);
-        if (!res || res->status != httplib::StatusCode::OK_200) {
-            std::string errorDetail;
-            if (res) {
-                errorDetail = "HTTP error " + std::to_string(res->status);
-            } else {
-                errorDetail = "Unable to reach server at all or no internet connection";
-            }
-            PLOGE << "Error fetching version: " << errorDetail;
-            MainThreadShared::ShouldRun = false;
-            return { false, false };
-        }
-
-        std::string cleanBody = res->body;
-        absl::StripAsciiWhitespace(&cleanBody);
-        auto mandatoryVersion = semver::version(cleanBody);
-        if (VERSION < mandatoryVersion) {
-            MainThreadShared::ShouldRun = false;
-            PLOGE << "Mandatory update required: " << VERSION.to_string() << " -> "
-                  << mandatoryVersion.to_string();
-            return { true, true };
-        }
-    } catch (const std::exception& e) {
-        MainThreadShared::ShouldRun = false;
-        PLOGE << "Error parsing version: " << e.what();
-        return { false, false };
-    }
-
-    return { true, false };
+    return { { "pending", result.state == VersionCheckState::kPending },
+        { "needUpdate", result.state == VersionCheckState::kUpdateRequired },
+        { "checkSuccessful",
+            result.state == VersionCheckState::kUpToDate
+                || result.state == VersionCheckState::kUpdateRequired },
+        { "fromCache", result.fromCache }, { "mandatoryVersion", result.mandatoryVersion } };
 }
 
-Napi::Object Bootstrap(const Napi::CallbackInfo& info)
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+Napi::Object BootstrapSubsystems(const Napi::CallbackInfo& info)
 {
-    LogFactory::createLoggers();
+    {
+        StartupProfiler::Phase phase("createLoggers");
+        LogFactory::createLoggers();
+    }
     PLOGI << "Starting TrackAudio...";
     auto outObject = Napi::Object::New(info.Env());
 
@@ -949,46 +1319,68 @@ Napi::Object Bootstrap(const Napi::CallbackInfo& info)
     outObject["needUpdate"] = Napi::Boolean::New(info.Env(), false);
     outObject["checkSuccessful"] = Napi::Boolean::New(info.Env(), true);
 
-    PLOGI << "Checking version...";
-    const auto versionCheckResponse = CheckVersionSync();
-    PLOGI << "Version check response obtained, verifying...";
-
-    if (!versionCheckResponse.success) {
-        outObject["canRun"] = Napi::Boolean::New(info.Env(), false);
-        outObject["checkSuccessful"] = Napi::Boolean::New(info.Env(), versionCheckResponse.success);
-        PLOGE << "Version check failed, cannot run TrackAudio";
-        return outObject;
-    }
-
-    if (versionCheckResponse.needUpdate) {
-        outObject["needUpdate"] = Napi::Boolean::New(info.Env(), true);
-        outObject["canRun"] = Napi::Boolean::New(info.Env(), false);
-        PLOGE << "Mandatory update required, cannot run TrackAudio";
-        return outObject;
+    // The version check runs alongside the rest of the initialisation, only an update required
+    // by the cached mandatory version is known this early
+    {
+        StartupProfiler::Phase phase("versionCheckStart");
+        MainThreadShared::versionChecker = std::make_unique<VersionChecker>();
+        if (MainThreadShared::versionChecker->result().state
+            == VersionCheckState::kUpdateRequired) {
+            outObject["needUpdate"] = Napi::Boolean::New(info.Env(), true);
+            outObject["canRun"] = Napi::Boolean::New(info.Env(), false);
+            PLOGE << "Mandatory update required, cannot run TrackAudio";
+            return outObject;
+        }
+        PLOGI << "Checking version in the background...";
+        MainThreadShared::versionChecker->start();
     }
 
-    PLOGI << "Version check successful, continuing...";
-
     if (info.Length() < 1 || !info[0].IsString()) {
         throw Napi::Error::New(info.Env(), "Resource path is required");
     }
     std::string resourcePath = info[0].As<Napi::String>().Utf8Value();
     MainThreadShared::resourcePath = resourcePath;
-    if (info.Length() > 1 && info[1].IsString()) {
-        std::string request = info[1].As<Napi::String>().Utf8Value();
-        mClient = std::make_unique<afv_native::api::atcClient>(CLIENT_NAME, resourcePath, request);
-    } else {
-        mClient = std::make_unique<afv_native::api::atcClient>(CLIENT_NAME, resourcePath);
+    {
+        StartupProfiler::Phase phase("atcClient");
+        if (info.Length() > 1 && info[1].IsString()) {
+            std::string request = info[1].As<Napi::String>().Utf8Value();
+            mClient = std::make_unique<AtcClient>(CLIENT_NAME, resourcePath, request);
+        } else {
+            mClient = std::make_unique<AtcClient>(CLIENT_NAME, resourcePath);
+        }
+    }
+
+    {
+        StartupProfiler::Phase phase("audioDeviceCatalog");
+        MainThreadShared::audioDeviceCatalog = std::make_unique<AudioDeviceCatalog>(
+            CreateAudioDeviceCatalogSource(),
+            []() { NapiHelpers::callElectron("AudioDevicesChanged"); });
     }
+    MainThreadShared::guardUnicomTransceivers
+        = std::make_unique<GuardUnicomTransceivers>(CreateGuardUnicomTransceiverSource());
 
     try {
-        MainThreadShared::mRemoteDataHandler = std::make_unique<RemoteData>();
+        {
+            StartupProfiler::Phase phase("remoteData");
+            MainThreadShared::mRemoteDataHandler
+                = std::make_unique<RemoteData>([](const NetworkSession& session) {
+                      if (MainThreadShared::mApiServer) {
+                          MainThreadShared::mApiServer->publishNetworkSession(session.isConnected,
+                              session.callsign, session.frequency, session.isAtc);
+                      }
+                  });
+        }
         PLOGI << "Remote data handler created successfully";
-        MainThreadShared::mApiServer = std::make_shared<SDK>();
+        {
+            StartupProfiler::Phase phase("sdk");
+            MainThreadShared::mApiServer = std::make_shared<SDK>();
+        }
         PLOGI << "SDK server created successfully";
     } catch (const std::exception& e) {
         MainThreadShared::mRemoteDataHandler.reset();
         MainThreadShared::mApiServer.reset();
+        MainThreadShared::audioDeviceCatalog.reset();
+        MainThreadShared::guardUnicomTransceivers.reset();
         mClient.reset();
         outObject["canRun"] = Napi::Boolean::New(info.Env(), false);
         PLOGE << "Error creating remote data handler or SDK: " << e.what();
@@ -996,26 +1388,70 @@ Napi::Object Bootstrap(const Napi::CallbackInfo& info)
     }
 
     // Setup afv
-    HandleAfvEvents();
+    {
+        StartupProfiler::Phase phase("afvEventHandlers");
+        HandleAfvEvents();
+    }
     PLOGI << "AFV events handlers set up successfully";
 
     try {
+        StartupProfiler::Phase phase("inputHandler");
         MainThreadShared::inputHandler = std::make_unique<InputHandler>();
     } catch (const std::exception& e) {
         MainThreadShared::inputHandler.reset();
         MainThreadShared::mApiServer.reset();
         MainThreadShared::mRemoteDataHandler.reset();
+        MainThreadShared::audioDeviceCatalog.reset();
+        MainThreadShared::guardUnicomTransceivers.reset();
         mClient.reset();
         outObject["canRun"] = Napi::Boolean::New(info.Env(), false);
         PLOGE << "Error creating input handler: " << e.what();
         return outObject;
     }
 
-    UserSettings::load();
+    {
+        StartupProfiler::Phase phase("userSettings");
+        UserSettings::load();
+        InputHandler::publishPttBindings();
+    }
+
+    return outObject;
+}
 
+Napi::Object Bootstrap(const Napi::CallbackInfo& info)
+{
+    Napi::Object outObject;
+    {
+        StartupProfiler::Phase phase("bootstrap");
+        outObject = BootstrapSubsystems(info);
+    }
+    StartupProfiler::finish();
     return outObject;
 }
 
+Napi::Value GetStartupReport(const Napi::CallbackInfo& info)
+{
+    return NapiHelpers::JsonToNapiValue(info.Env(), StartupProfiler::report());
+}
+
+Napi::Value GetPttLatencyReport(const Napi::CallbackInfo& info)
+{
+    return NapiHelpers::JsonToNapiValue(info.Env(), PttLatency::report());
+}
+
+void ResetPttLatencyReport(const Napi::CallbackInfo& /*info*/) { PttLatency::reset(); }
+
+Napi::Promise GetVersionCheckResult(const Napi::CallbackInfo& info)
+{
+    return NapiHelpers::HandleSimplePromise<nlohmann::json>(info.Env(), "version-check", []() {
+        if (!MainThreadShared::versionChecker) {
+            return VersionCheckResultToJson({});
+        }
+        return VersionCheckResultToJson(
+            MainThreadShared::versionChecker->awaitResult(std::chrono::seconds(25)));
+    });
+}
+
 void SetSession(const Napi::CallbackInfo& info)
 {
     auto object = info[0].As<Napi::Object>();
@@ -1042,6 +1478,146 @@ void SetSession(const Napi::CallbackInfo& info)
     UserSession::frequency = frequency;
 }
 
+#ifdef TRACKAUDIO_FAKE_AFV
+// Scripted AFV events, trace replay and the slurper stand-in inject synthetic traffic and are
+// only built along with the fake AFV client
+void RunAfvEventScript(const Napi::CallbackInfo& info)
+{
+    auto scriptPath = info[0].As<Napi::String>().Utf8Value();
+    double speed = info.Length() > 1 ? info[1].As<Napi::Number>().DoubleValue() : 1.0;
+    int repeat = info.Length() > 2 ? info[2].As<Napi::Number>().Int32Value() : 1;
+
+    std::vector<AfvScriptedEvent> timeline;
+    try {
+        timeline = AfvEventInjector::loadScript(scriptPath);
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(info.Env(), e.what());
+    }
+
+    if (!MainThreadShared::eventInjector) {
+        MainThreadShared::eventInjector = std::make_unique<AfvEventInjector>();
+    }
+    MainThreadShared::eventInjector->start(std::move(timeline), speed, repeat);
+}
+
+void StopAfvEventScript(const Napi::CallbackInfo& /*info*/)
+{
+    if (MainThreadShared::eventInjector) {
+        MainThreadShared::eventInjector->stop();
+    }
+}
+#endif
+
+Napi::String StartTraceRecording(const Napi::CallbackInfo& info)
+{
+    auto tracePath = info.Length() > 0 && info[0].IsString()
+        ? std::filesystem::path(info[0].As<Napi::String>().Utf8Value())
+        : TraceRecorder::defaultTracePath();
+
+    if (!TraceRecorder::start(tracePath)) {
+        throw Napi::Error::New(info.Env(), "Could not create trace file " + tracePath.string());
+    }
+    return Napi::String::New(info.Env(), tracePath.string());
+}
+
+Napi::Number StopTraceRecording(const Napi::CallbackInfo& info)
+{
+    TraceRecorder::stop();
+    return Napi::Number::New(info.Env(), static_cast<double>(TraceRecorder::droppedRecords()));
+}
+
+#ifdef TRACKAUDIO_FAKE_AFV
+void ReplayTrace(const Napi::CallbackInfo& info)
+{
+    auto tracePath = info[0].As<Napi::String>().Utf8Value();
+    double speed = info.Length() > 1 ? info[1].As<Napi::Number>().DoubleValue() : 1.0;
+
+    if (!MainThreadShared::traceReplayer) {
+        MainThreadShared::traceReplayer
+            = std::make_unique<TraceReplayer>([](std::string_view payload) {
+                  if (MainThreadShared::mApiServer) {
+                      MainThreadShared::mApiServer->replayWebSocketRequest(std::string(payload));
+                  }
+              });
+    }
+
+    try {
+        MainThreadShared::traceReplayer->start(tracePath, speed);
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(info.Env(), e.what());
+    }
+}
+
+void StopTraceReplay(const Napi::CallbackInfo& /*info*/)
+{
+    if (MainThreadShared::traceReplayer) {
+        MainThreadShared::traceReplayer->stop();
+    }
+}
+#endif
+
+/**
+ * @brief Overrides the slurper and version check base URLs, missing or empty keys restore the
+ * default. Call before Bootstrap for the override to apply to the startup version check.
+ */
+void SetRemoteEndpoints(const Napi::CallbackInfo& info)
+{
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        throw Napi::TypeError::New(info.Env(), "An endpoints object is required");
+    }
+    auto endpoints = info[0].As<Napi::Object>();
+    auto readUrl = [&endpoints](const char* key, const char* fallback) {
+        auto value = endpoints.Get(key);
+        auto url = value.IsString() ? value.As<Napi::String>().Utf8Value() : "";
+        return url.empty() ? std::string(fallback) : url;
+    };
+
+    std::lock_guard<std::mutex> lock(RemoteEndpoints::mtx);
+    RemoteEndpoints::slurperBaseUrl = readUrl("slurperBaseUrl", SLURPER_BASE_URL);
+    RemoteEndpoints::versionCheckBaseUrl
+        = readUrl("versionCheckBaseUrl", VERSION_CHECK_BASE_URL);
+    PLOGI << "Remote endpoints: slurper " << RemoteEndpoints::slurperBaseUrl
+          << ", version check " << RemoteEndpoints::versionCheckBaseUrl;
+}
+
+#ifdef TRACKAUDIO_FAKE_AFV
+Napi::String StartSlurperStandIn(const Napi::CallbackInfo& info)
+{
+    auto scriptPath = info[0].As<Napi::String>().Utf8Value();
+
+    if (!MainThreadShared::slurperStandIn) {
+        MainThreadShared::slurperStandIn = std::make_unique<SlurperStandIn>();
+    }
+
+    try {
+        auto baseUrl
+            = MainThreadShared::slurperStandIn->start(SlurperStandIn::loadScript(scriptPath));
+        return Napi::String::New(info.Env(), baseUrl);
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(info.Env(), e.what());
+    }
+}
+
+void StopSlurperStandIn(const Napi::CallbackInfo& /*info*/)
+{
+    if (MainThreadShared::slurperStandIn) {
+        MainThreadShared::slurperStandIn->stop();
+    }
+}
+
+Napi::Value GetSlurperStandInRequests(const Napi::CallbackInfo& info)
+{
+    auto requests = nlohmann::json::array();
+    if (MainThreadShared::slurperStandIn) {
+        for (const auto& request : MainThreadShared::slurperStandIn->requests()) {
+            requests.push_back({ { "offsetMs", request.offset.count() }, { "path", request.path },
+                { "status", request.status } });
+        }
+    }
+    return NapiHelpers::JsonToNapiValue(info.Env(), requests);
+}
+#endif
+
 Napi::Boolean Exit(const Napi::CallbackInfo& info)
 {
     PLOGI << "Awaiting to exit TrackAudio...";
@@ -1049,12 +1625,20 @@ Napi::Boolean Exit(const Napi::CallbackInfo& info)
     // 1. Signal exit first so callbacks stop being queued
     NapiHelpers::_requestExit.store(true);
 
-    // 2. Stop VU meter thread properly (signal + join)
-    MainThreadShared::runVuMeterCallback = false;
-    if (MainThreadShared::vuMeterThread && MainThreadShared::vuMeterThread->joinable()) {
-        MainThreadShared::vuMeterThread->join();
+    // 2. Stop the mic test so no more levels are sampled
+    MainThreadShared::micTestRunning = false;
+
+#ifdef TRACKAUDIO_FAKE_AFV
+    // Stop any scripted event playback before its events reach the handlers below
+    MainThreadShared::eventInjector.reset();
+    MainThreadShared::traceReplayer.reset();
+    MainThreadShared::slurperStandIn.reset();
+#endif
+
+    // Async calls may still be waiting on the version check, only stop it here
+    if (MainThreadShared::versionChecker) {
+        MainThreadShared::versionChecker->stop();
     }
-    MainThreadShared::vuMeterThread.reset();
 
     // 3. Remove all EventBus handlers so the async worker thread won't invoke
     //    stale callbacks that reference mClient/mApiServer after they're destroyed
@@ -1070,8 +1654,14 @@ Napi::Boolean Exit(const Napi::CallbackInfo& info)
     MainThreadShared::inputHandler.reset();
     MainThreadShared::mRemoteDataHandler.reset();
     MainThreadShared::mApiServer.reset();
+    MainThreadShared::audioDeviceCatalog.reset();
+    RadioHelper::stopGainUpdates();
+    if (MainThreadShared::guardUnicomTransceivers) {
+        MainThreadShared::guardUnicomTransceivers->stop();
+    }
 
-    // 5. Now safe to disconnect and destroy mClient
+    // 5. Now safe to disconnect and destroy mClient, once no async operation is using it
+    std::lock_guard<std::mutex> clientLock(MainThreadShared::clientOperationMutex);
     if (mClient && mClient->IsVoiceConnected()) {
         PLOGI << "Connection to network detected, forcing disconnect...";
         mClient->Disconnect();
@@ -1083,6 +1673,7 @@ Napi::Boolean Exit(const Napi::CallbackInfo& info)
     }
 
     mClient.reset();
+    TraceRecorder::stop();
     PLOGI << "Exiting TrackAudio...";
     LogFactory::destroyLoggers();
 
@@ -1094,109 +1685,248 @@ Napi::String GetLoggerFilePath(const Napi::CallbackInfo& info)
     return Napi::String::New(info.Env(), LogFactory::getLoggerFilePath());
 }
 
+std::string DescribeArguments(const Napi::CallbackInfo& info, std::string_view functionName)
+{
+    // Connect takes the user's password as its first argument
+    if (functionName == "Connect" || functionName == "ConnectAsync") {
+        return "<redacted>";
+    }
+
+    std::string description;
+    for (size_t i = 0; i < info.Length(); i++) {
+        if (i > 0) {
+            description += ", ";
+        }
+        const auto& arg = info[i];
+        if (arg.IsString()) {
+            description += "\"" + arg.As<Napi::String>().Utf8Value() + "\"";
+        } else if (arg.IsNumber()) {
+            description += std::to_string(arg.As<Napi::Number>().DoubleValue());
+        } else if (arg.IsBoolean()) {
+            description += arg.As<Napi::Boolean>().Value() ? "true" : "false";
+        } else if (arg.IsFunction()) {
+            description += "<function>";
+        } else {
+            description += "<object>";
+        }
+    }
+    return description;
+}
+
+/**
+ * @brief Creates an exported function that records each call while a trace is running.
+ */
+template <typename Callback>
+Napi::Function TracedFunction(Napi::Env env, const char* name, Callback callback)
+{
+    return Napi::Function::New(
+        env,
+        [name, callback](const Napi::CallbackInfo& info) {
+            if (TraceRecorder::isRecording()) {
+                TraceRecorder::recordCommand(
+                    trace::RecordKind::kNapiCall, name, DescribeArguments(info, name));
+            }
+            return callback(info);
+        },
+        name);
+}
+
 Napi::Object Init(Napi::Env env, Napi::Object exports)
 {
+    StartupProfiler::Phase phase("init");
 
-    exports.Set(Napi::String::New(env, "GetVersion"), Napi::Function::New(env, Version));
+    exports.Set(Napi::String::New(env, "GetVersion"), TracedFunction(env, "GetVersion", Version));
 
-    exports.Set(Napi::String::New(env, "GetAudioApis"), Napi::Function::New(env, GetAudioApis));
+    exports.Set(Napi::String::New(env, "GetAudioApis"),
+        TracedFunction(env, "GetAudioApis", GetAudioApis));
 
     exports.Set(Napi::String::New(env, "GetAudioInputDevices"),
-        Napi::Function::New(env, GetAudioInputDevices));
+        TracedFunction(env, "GetAudioInputDevices", GetAudioInputDevices));
+
+    exports.Set(Napi::String::New(env, "GetAudioInputDevicesAsync"),
+        TracedFunction(env, "GetAudioInputDevicesAsync", GetAudioInputDevicesAsync));
 
     exports.Set(Napi::String::New(env, "GetAudioOutputDevices"),
-        Napi::Function::New(env, GetAudioOutputDevices));
+        TracedFunction(env, "GetAudioOutputDevices", GetAudioOutputDevices));
 
-    exports.Set(Napi::String::New(env, "Connect"), Napi::Function::New(env, Connect));
+    exports.Set(Napi::String::New(env, "GetAudioOutputDevicesAsync"),
+        TracedFunction(env, "GetAudioOutputDevicesAsync", GetAudioOutputDevicesAsync));
 
-    exports.Set(Napi::String::New(env, "Disconnect"), Napi::Function::New(env, Disconnect));
+    exports.Set(Napi::String::New(env, "Connect"), TracedFunction(env, "Connect", Connect));
 
-    exports.Set(
-        Napi::String::New(env, "SetAudioSettings"), Napi::Function::New(env, SetAudioSettings));
+    exports.Set(Napi::String::New(env, "ConnectAsync"),
+        TracedFunction(env, "ConnectAsync", ConnectAsync));
 
-    exports.Set(Napi::String::New(env, "AddFrequency"), Napi::Function::New(env, AddFrequency));
+    exports.Set(Napi::String::New(env, "Disconnect"),
+        TracedFunction(env, "Disconnect", Disconnect));
 
-    exports.Set(
-        Napi::String::New(env, "RemoveFrequency"), Napi::Function::New(env, RemoveFrequency));
+    exports.Set(Napi::String::New(env, "SetAudioSettings"),
+        TracedFunction(env, "SetAudioSettings", SetAudioSettings));
 
-    exports.Set(
-        Napi::String::New(env, "SetFrequencyState"), Napi::Function::New(env, SetFrequencyState));
+    exports.Set(Napi::String::New(env, "SetAudioSettingsAsync"),
+        TracedFunction(env, "SetAudioSettingsAsync", SetAudioSettingsAsync));
 
-    exports.Set(
-        Napi::String::New(env, "GetFrequencyState"), Napi::Function::New(env, GetFrequencyState));
+    exports.Set(Napi::String::New(env, "AddFrequency"),
+        TracedFunction(env, "AddFrequency", AddFrequency));
 
-    exports.Set(
-        Napi::String::New(env, "RegisterCallback"), Napi::Function::New(env, RegisterCallback));
+    exports.Set(Napi::String::New(env, "AddFrequencyAsync"),
+        TracedFunction(env, "AddFrequencyAsync", AddFrequencyAsync));
 
-    exports.Set(Napi::String::New(env, "GetStation"), Napi::Function::New(env, GetStation));
+    exports.Set(Napi::String::New(env, "RemoveFrequency"),
+        TracedFunction(env, "RemoveFrequency", RemoveFrequency));
 
-    exports.Set(Napi::String::New(env, "RefreshStation"), Napi::Function::New(env, RefreshStation));
+    exports.Set(Napi::String::New(env, "SetFrequencyState"),
+        TracedFunction(env, "SetFrequencyState", SetFrequencyState));
 
-    exports.Set(
-        Napi::String::New(env, "IsFrequencyActive"), Napi::Function::New(env, IsFrequencyActive));
+    exports.Set(Napi::String::New(env, "AddFrequencies"),
+        TracedFunction(env, "AddFrequencies", AddFrequencies));
+
+    exports.Set(Napi::String::New(env, "SetFrequencyStates"),
+        TracedFunction(env, "SetFrequencyStates", SetFrequencyStates));
+
+    exports.Set(Napi::String::New(env, "GetFrequencyState"),
+        TracedFunction(env, "GetFrequencyState", GetFrequencyState));
+
+    exports.Set(Napi::String::New(env, "RegisterCallback"),
+        TracedFunction(env, "RegisterCallback", RegisterCallback));
+
+    exports.Set(Napi::String::New(env, "GetEventQueueStats"),
+        TracedFunction(env, "GetEventQueueStats", GetEventQueueStats));
+
+    exports.Set(Napi::String::New(env, "GetStation"),
+        TracedFunction(env, "GetStation", GetStation));
+
+    exports.Set(Napi::String::New(env, "RefreshStation"),
+        TracedFunction(env, "RefreshStation", RefreshStation));
+
+    exports.Set(Napi::String::New(env, "IsFrequencyActive"),
+        TracedFunction(env, "IsFrequencyActive", IsFrequencyActive));
+
+    exports.Set(Napi::String::New(env, "Reset"), TracedFunction(env, "Reset", Reset));
 
-    exports.Set(Napi::String::New(env, "Reset"), Napi::Function::New(env, Reset));
+    exports.Set(Napi::String::New(env, "SetCid"), TracedFunction(env, "SetCid", SetCid));
 
-    exports.Set(Napi::String::New(env, "SetCid"), Napi::Function::New(env, SetCid));
+    exports.Set(Napi::String::New(env, "GetNetworkSession"),
+        TracedFunction(env, "GetNetworkSession", GetNetworkSession));
 
-    exports.Set(Napi::String::New(env, "SetPtt"), Napi::Function::New(env, SetPtt));
+    exports.Set(Napi::String::New(env, "SetPtt"), TracedFunction(env, "SetPtt", SetPtt));
 
     exports.Set(Napi::String::New(env, "SetFrequencyRadioVolume"),
-        Napi::Function::New(env, SetFrequencyRadioVolume));
+        TracedFunction(env, "SetFrequencyRadioVolume", SetFrequencyRadioVolume));
 
-    exports.Set(
-        Napi::String::New(env, "SetMainRadioVolume"), Napi::Function::New(env, SetMainRadioVolume));
+    exports.Set(Napi::String::New(env, "SetMainRadioVolume"),
+        TracedFunction(env, "SetMainRadioVolume", SetMainRadioVolume));
 
     exports.Set(Napi::String::New(env, "SetMicrophoneVolume"),
-        Napi::Function::New(env, SetMicrophoneVolume));
+        TracedFunction(env, "SetMicrophoneVolume", SetMicrophoneVolume));
 
-    exports.Set(
-        Napi::String::New(env, "SetRadioEffects"), Napi::Function::New(env, SetRadioEffects));
+    exports.Set(Napi::String::New(env, "SetRadioEffects"),
+        TracedFunction(env, "SetRadioEffects", SetRadioEffects));
 
-    exports.Set(
-        Napi::String::New(env, "SetHardwareType"), Napi::Function::New(env, SetHardwareType));
+    exports.Set(Napi::String::New(env, "SetHardwareType"),
+        TracedFunction(env, "SetHardwareType", SetHardwareType));
+
+    exports.Set(Napi::String::New(env, "Bootstrap"), TracedFunction(env, "Bootstrap", Bootstrap));
+
+    exports.Set(Napi::String::New(env, "GetVersionCheckResult"),
+        TracedFunction(env, "GetVersionCheckResult", GetVersionCheckResult));
+
+    exports.Set(Napi::String::New(env, "GetStartupReport"),
+        TracedFunction(env, "GetStartupReport", GetStartupReport));
 
-    exports.Set(Napi::String::New(env, "Bootstrap"), Napi::Function::New(env, Bootstrap));
+    exports.Set(Napi::String::New(env, "GetPttLatencyReport"),
+        TracedFunction(env, "GetPttLatencyReport", GetPttLatencyReport));
 
-    exports.Set(Napi::String::New(env, "IsConnected"), Napi::Function::New(env, IsConnected));
+    exports.Set(Napi::String::New(env, "ResetPttLatencyReport"),
+        TracedFunction(env, "ResetPttLatencyReport", ResetPttLatencyReport));
 
+    exports.Set(Napi::String::New(env, "IsConnected"),
+        TracedFunction(env, "IsConnected", IsConnected));
+
+    exports.Set(Napi::String::New(env, "GetStateFolder"),
+        TracedFunction(env, "GetStateFolder", GetStateFolderNapi));
+
+    exports.Set(Napi::String::New(env, "StartMicTest"),
+        TracedFunction(env, "StartMicTest", StartMicTest));
+
+    // Polled every frame, so it is kept out of traces
     exports.Set(
-        Napi::String::New(env, "GetStateFolder"), Napi::Function::New(env, GetStateFolderNapi));
+        Napi::String::New(env, "ReadInputLevels"), Napi::Function::New(env, ReadInputLevels));
 
-    exports.Set(Napi::String::New(env, "StartMicTest"), Napi::Function::New(env, StartMicTest));
+    exports.Set(Napi::String::New(env, "StopMicTest"),
+        TracedFunction(env, "StopMicTest", StopMicTest));
 
-    exports.Set(Napi::String::New(env, "StopMicTest"), Napi::Function::New(env, StopMicTest));
+    exports.Set(Napi::String::New(env, "StartAudio"),
+        TracedFunction(env, "StartAudio", StartAudio));
 
-    exports.Set(Napi::String::New(env, "StartAudio"), Napi::Function::New(env, StartAudio));
+    exports.Set(Napi::String::New(env, "StartAudioAsync"),
+        TracedFunction(env, "StartAudioAsync", StartAudioAsync));
 
-    exports.Set(Napi::String::New(env, "StopAudio"), Napi::Function::New(env, StopAudio));
+    exports.Set(Napi::String::New(env, "StopAudio"), TracedFunction(env, "StopAudio", StopAudio));
 
-    exports.Set(Napi::String::New(env, "SetupPttBegin"), Napi::Function::New(env, SetupPttBegin));
+    exports.Set(Napi::String::New(env, "SetupPttBegin"),
+        TracedFunction(env, "SetupPttBegin", SetupPttBegin));
 
-    exports.Set(Napi::String::New(env, "SetupPttEnd"), Napi::Function::New(env, SetupPttEnd));
+    exports.Set(Napi::String::New(env, "SetupPttEnd"),
+        TracedFunction(env, "SetupPttEnd", SetupPttEnd));
 
-    exports.Set(Napi::String::New(env, "ClearPtt"), Napi::Function::New(env, ClearPtt));
+    exports.Set(Napi::String::New(env, "ClearPtt"), TracedFunction(env, "ClearPtt", ClearPtt));
 
-    exports.Set(
-        Napi::String::New(env, "RequestPttKeyName"), Napi::Function::New(env, RequestPttKeyName));
+    exports.Set(Napi::String::New(env, "RequestPttKeyName"),
+        TracedFunction(env, "RequestPttKeyName", RequestPttKeyName));
 
-    exports.Set(
-        Napi::String::New(env, "GetLoggerFilePath"), Napi::Function::New(env, GetLoggerFilePath));
+    exports.Set(Napi::String::New(env, "GetLoggerFilePath"),
+        TracedFunction(env, "GetLoggerFilePath", GetLoggerFilePath));
 
-    exports.Set(Napi::String::New(env, "PlayAdHocSound"), Napi::Function::New(env, PlayAdHocSound));
+    exports.Set(Napi::String::New(env, "PlayAdHocSound"),
+        TracedFunction(env, "PlayAdHocSound", PlayAdHocSound));
 
-    exports.Set(
-        Napi::String::New(env, "StopAdHocSounds"), Napi::Function::New(env, StopAdHocSounds));
+    exports.Set(Napi::String::New(env, "StopAdHocSounds"),
+        TracedFunction(env, "StopAdHocSounds", StopAdHocSounds));
 
     exports.Set(Napi::String::New(env, "SetPttReleaseSoundEnabled"),
-        Napi::Function::New(env, SetPttReleaseSoundEnabled));
+        TracedFunction(env, "SetPttReleaseSoundEnabled", SetPttReleaseSoundEnabled));
 
-    exports.Set(Napi::String::New(env, "SetLoopback"), Napi::Function::New(env, SetLoopback));
+    exports.Set(Napi::String::New(env, "SetLoopback"),
+        TracedFunction(env, "SetLoopback", SetLoopback));
 
-    exports.Set(Napi::String::New(env, "Exit"), Napi::Function::New(env, Exit));
+    exports.Set(Napi::String::New(env, "Exit"), TracedFunction(env, "Exit", Exit));
 
     // Debugging
-    exports.Set(Napi::String::New(env, "SetSession"), Napi::Function::New(env, SetSession));
+    exports.Set(Napi::String::New(env, "SetSession"),
+        TracedFunction(env, "SetSession", SetSession));
+
+    exports.Set(Napi::String::New(env, "StartTraceRecording"),
+        TracedFunction(env, "StartTraceRecording", StartTraceRecording));
+
+    exports.Set(Napi::String::New(env, "StopTraceRecording"),
+        TracedFunction(env, "StopTraceRecording", StopTraceRecording));
+
+    exports.Set(Napi::String::New(env, "SetRemoteEndpoints"),
+        TracedFunction(env, "SetRemoteEndpoints", SetRemoteEndpoints));
+
+#ifdef TRACKAUDIO_FAKE_AFV
+    exports.Set(Napi::String::New(env, "RunAfvEventScript"),
+        TracedFunction(env, "RunAfvEventScript", RunAfvEventScript));
+
+    exports.Set(Napi::String::New(env, "StopAfvEventScript"),
+        TracedFunction(env, "StopAfvEventScript", StopAfvEventScript));
+
+    exports.Set(Napi::String::New(env, "ReplayTrace"),
+        TracedFunction(env, "ReplayTrace", ReplayTrace));
+
+    exports.Set(Napi::String::New(env, "StopTraceReplay"),
+        TracedFunction(env, "StopTraceReplay", StopTraceReplay));
+
+    exports.Set(Napi::String::New(env, "StartSlurperStandIn"),
+        TracedFunction(env, "StartSlurperStandIn", StartSlurperStandIn));
+
+    exports.Set(Napi::String::New(env, "StopSlurperStandIn"),
+        TracedFunction(env, "StopSlurperStandIn", StopSlurperStandIn));
+
+    exports.Set(Napi::String::New(env, "GetSlurperStandInRequests"),
+        TracedFunction(env, "GetSlurperStandInRequests", GetSlurperStandInRequests));
+#endif
 
     return exports;
 }
@@ -1,7 +1,9 @@
 #include "sdk.hpp"
 #include "Helpers.hpp"
+#include "PttLatency.hpp"
 #include "RadioHelper.hpp"
 #include "Shared.hpp"
+#include "TraceRecorder.hpp"
 #include <plog/Log.h>
 
 SDK::SDK() { this->buildServer(); }
@@ -60,14 +62,14 @@ void SDK::sendMessage(uint64_t clientId, const std::string& data)
     }
 }
 
-void SDK::broadcastMessage(const std::string& data, MessageScope scope,
+void SDK::broadcastMessage(const nlohmann::json& data, MessageScope scope,
     const std::optional<std::string>& electronEventName)
 {
     std::lock_guard<std::mutex> lock(BroadcastMutex);
 
     restinio::websocket::basic::message_t message;
     message.set_opcode(restinio::websocket::basic::opcode_t::text_frame);
-    message.set_payload(data);
+    message.set_payload(data.dump());
 
     for (auto& [id, conn] : this->pWsRegistry) {
         if (conn.handle) {
@@ -148,7 +150,7 @@ void SDK::handleVoiceConnectedEventForWebsocket(bool isVoiceConnected)
     nlohmann::json jsonMessage
         = WebsocketMessage::buildMessage(WebsocketMessageType::kVoiceConnectedState);
     jsonMessage["value"]["connected"] = isVoiceConnected;
-    broadcastMessage(jsonMessage.dump(), MessageScope::AllClients);
+    broadcastMessage(jsonMessage, MessageScope::AllClients);
 }
 
 void SDK::handleAFVEventForWebsocket(sdk::types::Event event,
@@ -162,7 +164,7 @@ void SDK::handleAFVEventForWebsocket(sdk::types::Event event,
         jsonMessage["value"]["rx"] = nlohmann::json::array();
         jsonMessage["value"]["tx"] = nlohmann::json::array();
         jsonMessage["value"]["xc"] = nlohmann::json::array();
-        broadcastMessage(jsonMessage.dump(), MessageScope::AllClients);
+        broadcastMessage(jsonMessage, MessageScope::AllClients);
         return;
     }
 
@@ -175,7 +177,7 @@ void SDK::handleAFVEventForWebsocket(sdk::types::Event event,
         jsonMessage["value"]["callsign"] = *callsign;
         jsonMessage["value"]["pFrequencyHz"] = *frequencyHz;
         jsonMessage["value"]["activeTransmitters"] = *parameter3;
-        broadcastMessage(jsonMessage.dump(), MessageScope::AllClients);
+        broadcastMessage(jsonMessage, MessageScope::AllClients);
 
         std::lock_guard<std::mutex> lock(TransmittingMutex);
         CurrentlyTransmittingData.insert(*callsign);
@@ -187,7 +189,7 @@ void SDK::handleAFVEventForWebsocket(sdk::types::Event event,
         jsonMessage["value"]["callsign"] = *callsign;
         jsonMessage["value"]["pFrequencyHz"] = *frequencyHz;
         jsonMessage["value"]["activeTransmitters"] = *parameter3;
-        broadcastMessage(jsonMessage.dump(), MessageScope::AllClients);
+        broadcastMessage(jsonMessage, MessageScope::AllClients);
 
         std::lock_guard<std::mutex> lock(TransmittingMutex);
         CurrentlyTransmittingData.erase(*callsign);
@@ -196,13 +198,14 @@ void SDK::handleAFVEventForWebsocket(sdk::types::Event event,
 
     if (event == sdk::types::Event::kTxBegin) {
         nlohmann::json jsonMessage = WebsocketMessage::buildMessage(WebsocketMessageType::kTxBegin);
-        broadcastMessage(jsonMessage.dump(), MessageScope::AllClients);
+        broadcastMessage(jsonMessage, MessageScope::AllClients);
+        PttLatency::mark(PttLatencyStage::kSdkTxBegin);
         return;
     }
 
     if (event == sdk::types::Event::kTxEnd) {
         nlohmann::json jsonMessage = WebsocketMessage::buildMessage(WebsocketMessageType::kTxEnd);
-        broadcastMessage(jsonMessage.dump(), MessageScope::AllClients);
+        broadcastMessage(jsonMessage, MessageScope::AllClients);
         return;
     }
 
@@ -232,7 +235,7 @@ void SDK::handleAFVEventForWebsocket(sdk::types::Event event,
         jsonMessage["value"]["tx"] = std::move(txBar);
         jsonMessage["value"]["xc"] = std::move(xcBar);
 
-        broadcastMessage(jsonMessage.dump(), MessageScope::AllClients);
+        broadcastMessage(jsonMessage, MessageScope::AllClients);
         return;
     }
 
@@ -242,7 +245,7 @@ void SDK::handleAFVEventForWebsocket(sdk::types::Event event,
             return;
         }
 
-        broadcastMessage(this->buildStationStateJson(callsign, frequencyHz.value()).dump(),
+        broadcastMessage(this->buildStationStateJson(callsign, frequencyHz.value()),
             MessageScope::AllWithElectron);
         return;
     }
@@ -250,7 +253,7 @@ void SDK::handleAFVEventForWebsocket(sdk::types::Event event,
 
 void SDK::publishStationState(const nlohmann::json& state, bool broadcastToElectron)
 {
-    broadcastMessage(state.dump(),
+    broadcastMessage(state,
         broadcastToElectron ? MessageScope::AllWithElectron : MessageScope::AllClients,
         "station-state-update");
 }
@@ -260,7 +263,7 @@ void SDK::publishMainVolumeChange(const float& volume, bool broadcastToElectron)
     nlohmann::json jsonMessage
         = WebsocketMessage::buildMessage(WebsocketMessageType::kMainVolumeChange);
     jsonMessage["value"]["volume"] = volume;
-    broadcastMessage(jsonMessage.dump(),
+    broadcastMessage(jsonMessage,
         broadcastToElectron ? MessageScope::AllWithElectron : MessageScope::AllClients,
         "main-volume-change");
 }
@@ -276,7 +279,7 @@ void SDK::publishStationAdded(
         jsonMessage["value"]["frequencyAlias"] = frequencyAlias.value();
     }
 
-    broadcastMessage(jsonMessage.dump(), MessageScope::AllClients);
+    broadcastMessage(jsonMessage, MessageScope::AllClients);
 }
 
 void SDK::publishFrequencyRemoved(const int& frequencyHz)
@@ -284,7 +287,19 @@ void SDK::publishFrequencyRemoved(const int& frequencyHz)
     nlohmann::json jsonMessage
         = WebsocketMessage::buildMessage(WebsocketMessageType::kFrequencyRemoved);
     jsonMessage["value"]["frequency"] = frequencyHz;
-    broadcastMessage(jsonMessage.dump(), MessageScope::AllClients);
+    broadcastMessage(jsonMessage, MessageScope::AllClients);
+}
+
+void SDK::publishNetworkSession(
+    bool isConnected, const std::string& callsign, const int& frequencyHz, bool isAtc)
+{
+    nlohmann::json jsonMessage
+        = WebsocketMessage::buildMessage(WebsocketMessageType::kNetworkSessionUpdate);
+    jsonMessage["value"]["connected"] = isConnected;
+    jsonMessage["value"]["callsign"] = callsign;
+    jsonMessage["value"]["frequency"] = frequencyHz;
+    jsonMessage["value"]["isAtc"] = isAtc;
+    broadcastMessage(jsonMessage, MessageScope::AllClients);
 }
 
 std::unique_ptr<restinio::router::express_router_t<>> SDK::buildRouter()
@@ -361,8 +376,16 @@ restinio::request_handling_status_t SDK::handleTxSDKCall(const restinio::request
     return req->create_response().set_body(absl::StrJoin(outData, ",")).done();
 }
 
+void SDK::replayWebSocketRequest(const std::string& payload)
+{
+    // Replies addressed to the replay are dropped unless a live client happens to hold id 0
+    this->handleIncomingWebSocketRequest(payload, 0);
+}
+
 void SDK::handleIncomingWebSocketRequest(const std::string& payload, uint64_t clientId)
 {
+    TraceRecorder::recordCommand(trace::RecordKind::kSdkCommand, "websocket", payload);
+
     try {
         auto json = nlohmann::json::parse(payload);
         std::string messageType = json["type"];
@@ -375,6 +398,8 @@ void SDK::handleIncomingWebSocketRequest(const std::string& payload, uint64_t cl
             this->handleGetStationState(json["value"]["callsign"], clientId);
         } else if (messageType == "kGetMainVolume") {
             this->handleGetMainVolume(clientId);
+        } else if (messageType == "kGetPttLatency") {
+            this->handleGetPttLatency(clientId);
         } else if (messageType == "kPttPressed") {
             if (mClient) {
                 mClient->SetPtt(true);
@@ -544,10 +569,15 @@ void SDK::handleGetMainVolume(uint64_t requesterId)
 {
     nlohmann::json jsonMessage
         = WebsocketMessage::buildMessage(WebsocketMessageType::kMainVolumeChange);
-    {
-        std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
-        jsonMessage["value"]["volume"] = UserSession::currentMainVolume;
-    }
+    jsonMessage["value"]["volume"] = UserSession::currentMainVolume.load();
+    sendMessage(requesterId, jsonMessage.dump());
+}
+
+void SDK::handleGetPttLatency(uint64_t requesterId)
+{
+    nlohmann::json jsonMessage
+        = WebsocketMessage::buildMessage(WebsocketMessageType::kPttLatencyReport);
+    jsonMessage["value"] = PttLatency::report();
     sendMessage(requesterId, jsonMessage.dump());
 }
 
@@ -617,7 +647,7 @@ void SDK::handleChangeStationVolume(const nlohmann::json& json, uint64_t clientI
         auto updatedRadios = mClient->getRadioState();
         auto radioState = updatedRadios[frequency];
         auto stateJson = this->buildStationStateJson(radioState.stationName, frequency);
-        broadcastMessage(stateJson.dump(), MessageScope::AllWithElectron);
+        broadcastMessage(stateJson, MessageScope::AllWithElectron);
 
     } catch (const nlohmann::json::exception& e) {
         PLOG_ERROR << "Failed to process volume change: " << e.what();
@@ -638,13 +668,11 @@ void SDK::handleChangeMainVolume(const nlohmann::json& json, uint64_t clientId)
 
     try {
         auto amount = json["value"]["amount"].get<double>();
+        float currentVolume = UserSession::currentMainVolume.load();
         float newVolume = 0;
-        {
-            std::lock_guard<std::mutex> sessionLock(UserSession::mtx);
-            auto currentVolume = UserSession::currentMainVolume;
+        do {
             newVolume = static_cast<float>(std::clamp(currentVolume + amount, 0.0, 100.0));
-            UserSession::currentMainVolume = newVolume;
-        }
+        } while (!UserSession::currentMainVolume.compare_exchange_weak(currentVolume, newVolume));
         RadioHelper::setAllRadioVolumes();
 
         // Broadcast volume change to all clients
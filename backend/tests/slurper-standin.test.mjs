@@ -0,0 +1,126 @@
+// Drives the RemoteData session logic against the slurper stand-in and checks the network
+// session events through a connect, an outage and a disconnect.
+//
+// Needs an addon built with TRACKAUDIO_FAKE_AFV: `node scripts/build-napi.js --fake-afv`, then
+// `node --test tests/`. Takes about a minute as it runs on the real poll intervals.
+import assert from 'node:assert/strict';
+import { mkdtempSync, rmSync, writeFileSync } from 'node:fs';
+import { createRequire } from 'node:module';
+import { tmpdir } from 'node:os';
+import path from 'node:path';
+import { after, before, test } from 'node:test';
+
+const require = createRequire(import.meta.url);
+const { TrackAudioAfv, AfvEventTypes } = require('../js/bindings.js');
+
+const isFakeAfv = TrackAudioAfv.StartSlurperStandIn !== undefined;
+
+const atcLine = '1234567,EDDF_TWR,EDDF_TWR,119.900,0,50.0333,8.5706';
+// Offsets of the stand-in timeline, in ms. SetCid polls right away and then every 5 s, the
+// outage needs two failed polls before it is reported and is followed by a backed off retry.
+const outageStart = 7000;
+const outageEnd = 17000;
+const disconnectAt = 45000;
+
+let workDir;
+const events = [];
+
+const waitFor = (predicate, timeoutMs, description) =>
+    new Promise((resolve, reject) => {
+        const start = Date.now();
+        const poll = setInterval(() => {
+            const found = events.find(predicate);
+            if (found) {
+                clearInterval(poll);
+                resolve(found);
+            } else if (Date.now() - start > timeoutMs) {
+                clearInterval(poll);
+                reject(new Error(`Timed out waiting for ${description}`));
+            }
+        }, 50);
+    });
+
+const isSlurperError = (event) =>
+    event.name === AfvEventTypes.Error && event.args[0].startsWith('Error while parsing slurper');
+const isSlurperBack = (event) =>
+    event.name === AfvEventTypes.Error && event.args[0].startsWith('Slurper is back online');
+
+before(() => {
+    if (!isFakeAfv) {
+        return;
+    }
+
+    workDir = mkdtempSync(path.join(tmpdir(), 'trackaudio-test-'));
+    const scriptPath = path.join(workDir, 'slurper.txt');
+    writeFileSync(
+        scriptPath,
+        [
+            `0 Version ${TrackAudioAfv.GetVersion()}`,
+            `0 Body ${atcLine}`,
+            `${outageStart} Status 503`,
+            `${outageEnd} Body ${atcLine}`,
+            `${disconnectAt} Body`
+        ].join('\n')
+    );
+
+    const baseUrl = TrackAudioAfv.StartSlurperStandIn(scriptPath);
+    TrackAudioAfv.SetRemoteEndpoints({ slurperBaseUrl: baseUrl, versionCheckBaseUrl: baseUrl });
+
+    const bootstrap = TrackAudioAfv.Bootstrap(workDir);
+    assert.equal(bootstrap.canRun, true, 'Bootstrap failed, see the log file');
+
+    TrackAudioAfv.RegisterCallback((batch) => {
+        for (const [name, ...args] of batch) {
+            events.push({ name, args, time: Date.now() });
+        }
+    });
+    TrackAudioAfv.SetCid('1234567');
+});
+
+after(() => {
+    if (!isFakeAfv) {
+        return;
+    }
+    TrackAudioAfv.StopSlurperStandIn();
+    TrackAudioAfv.Exit();
+    rmSync(workDir, { recursive: true, force: true });
+});
+
+const options = { skip: !isFakeAfv && 'needs a TRACKAUDIO_FAKE_AFV build', timeout: 90000 };
+
+test('network session follows the slurper through an outage', options, async () => {
+    const connected = await waitFor(
+        (event) => event.name === AfvEventTypes.NetworkConnected,
+        outageStart,
+        'network-connected'
+    );
+    assert.deepEqual(connected.args, ['EDDF_TWR', true, 119900000]);
+
+    // Failed polls keep the session, the user is told once
+    await waitFor(isSlurperError, outageEnd, 'the slurper outage error');
+    await waitFor(isSlurperBack, disconnectAt, 'the slurper back online message');
+
+    const disconnected = await waitFor(
+        (event) => event.name === AfvEventTypes.NetworkDisconnected,
+        disconnectAt + 15000,
+        'network-disconnected'
+    );
+
+    const names = events.map((event) => event.name);
+    assert.equal(names.filter((name) => name === AfvEventTypes.NetworkConnected).length, 1);
+    assert.equal(names.filter((name) => name === AfvEventTypes.NetworkDisconnected).length, 1);
+    assert.equal(events.filter(isSlurperError).length, 1);
+    assert.ok(events.indexOf(connected) < events.findIndex(isSlurperError));
+    assert.ok(events.findIndex(isSlurperBack) < events.indexOf(disconnected));
+
+    const requests = TrackAudioAfv.GetSlurperStandInRequests();
+    const slurperRequests = requests.filter((request) => request.path.startsWith('/users/info'));
+    const failed = slurperRequests.filter((request) => request.status === 503);
+    assert.ok(failed.length >= 2, `expected two failed polls, got ${failed.length}`);
+    assert.ok(failed.every((r) => r.offsetMs >= outageStart && r.offsetMs < outageEnd + 1000));
+
+    // The disconnect is only reported once the empty body was served
+    const firstEmptyPoll = slurperRequests.find((request) => request.offsetMs >= disconnectAt);
+    assert.ok(firstEmptyPoll, 'no poll after the body was emptied');
+    assert.equal(firstEmptyPoll.status, 200);
+});
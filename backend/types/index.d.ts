@@ -9,12 +9,30 @@ export declare interface AudioDevice {
   isDefault: boolean;
 }
 
+export declare interface AudioDeviceList {
+  devices: AudioDevice[];
+  refreshing: boolean;
+}
+
+export declare interface FrequencyStateRecord {
+  frequency: number;
+  callsign?: string;
+  rx?: boolean;
+  tx?: boolean;
+  xc?: boolean;
+  onSpeaker?: boolean;
+  crossCoupleAcross?: boolean;
+  isOutputMuted?: boolean;
+  outputVolume?: number;
+}
+
 export declare const AfvEventTypes: {
   Error: string;
   VoiceConnected: string;
   VoiceDisconnected: string;
   StationTransceiversUpdated: string;
   StationDataReceived: string;
+  StationsDataReceived: string;
   FrequencyRxBegin: string;
   FrequencyRxEnd: string;
   StationRxBegin: string;
@@ -22,17 +40,104 @@ export declare const AfvEventTypes: {
   PttState: string;
   NetworkConnected: string;
   NetworkDisconnected: string;
-  VuMeter: string;
+  NetworkSessionChanged: string;
   PttKeySet: string;
   FrequencyStateUpdate: string;
   StationStateUpdate: string;
+  StationStatesUpdate: string;
   OpenSettingsModal: string;
   MainVolumeChange: string;
   AudioDeviceStopped: string;
+  AudioDevicesChanged: string;
   VoiceConnectionDegraded: string;
   VoiceConnectionResumed: string;
 };
 
+export declare type AfvEventArg = string | number | boolean | string[] | object | undefined;
+
+export declare type AfvEvent = [string, AfvEventArg, AfvEventArg, AfvEventArg];
+
+export declare interface EventQueueStats {
+  delivered: number;
+  batches: number;
+  coalesced: number;
+  dropped: number;
+  spilled: number;
+  pending: number;
+}
+
+export declare interface AsyncResult<T> {
+  event: string;
+  data: T;
+}
+
+export declare interface VersionCheckResult {
+  pending: boolean;
+  needUpdate: boolean;
+  checkSuccessful: boolean;
+  fromCache: boolean;
+  mandatoryVersion: string;
+}
+
+export declare interface StartupPhaseTiming {
+  name: string;
+  startMs: number;
+  wallMs: number;
+  cpuMs: number;
+}
+
+export declare interface StartupReport {
+  version: string;
+  timestamp: number;
+  finished: boolean;
+  sinceLoadMs: number;
+  phases: StartupPhaseTiming[];
+}
+
+export declare interface LatencyHistogram {
+  count: number;
+  meanUs: number;
+  p50Us: number;
+  p95Us: number;
+  p99Us: number;
+  maxUs: number;
+  // Only the non-empty buckets, maxUs is null for the bucket above 1 s
+  buckets: { count: number; maxUs: number | null }[];
+}
+
+export declare interface PttLatencyReport {
+  // Each stage measured from the previous one
+  stages: {
+    decision: LatencyHistogram;
+    setPtt: LatencyHistogram;
+    afvPttOpen: LatencyHistogram;
+    sdkTxBegin: LatencyHistogram;
+  };
+  // From the input event to the AFV PttOpenEvent
+  endToEnd: LatencyHistogram;
+  sources: { keyboard: number; joystickEvdev: number; joystickPoll: number };
+}
+
+export declare interface NetworkSession {
+  isConnected: boolean;
+  callsign: string;
+  isAtc: boolean;
+  frequency: number;
+  lat: number;
+  lon: number;
+}
+
+export declare interface RemoteEndpoints {
+  slurperBaseUrl?: string;
+  versionCheckBaseUrl?: string;
+}
+
+export declare interface SlurperStandInRequest {
+  offsetMs: number;
+  path: string;
+  status: number;
+}
+
 export declare interface Session {
   calos: string;
   fab: number;
@@ -44,16 +149,20 @@ export declare interface Session {
 
 declare namespace TrackAudioAfv {
   export function GetVersion(): string;
-  export function GetAudioApis(): Array<AudioApi>;
+  export function GetAudioApis(): { apis: Array<AudioApi>; refreshing: boolean };
 
-  export function GetAudioOutputDevices(
-    apiId: string
-  ): Promise<Array<AudioDevice>>;
-  export function GetAudioInputDevices(
-    apiId: string
-  ): Promise<Array<AudioDevice>>;
+  export function GetAudioOutputDevices(apiId: number): AudioDeviceList;
+  export function GetAudioInputDevices(apiId: number): AudioDeviceList;
+
+  export function GetAudioOutputDevicesAsync(
+    apiId: number
+  ): Promise<AsyncResult<AudioDeviceList>>;
+  export function GetAudioInputDevicesAsync(
+    apiId: number
+  ): Promise<AsyncResult<AudioDeviceList>>;
 
   export function Connect(password: string): Promise<boolean>;
+  export function ConnectAsync(password: string): Promise<AsyncResult<boolean>>;
   export function Disconnect(): void;
   export function SetAudioSettings(
     apiId: number,
@@ -61,12 +170,23 @@ declare namespace TrackAudioAfv {
     headsetDevice: string,
     speakerDevice: string
   ): void;
+  export function SetAudioSettingsAsync(
+    apiId: number,
+    inputDevice: string,
+    headsetDevice: string,
+    speakerDevice: string
+  ): Promise<AsyncResult<null>>;
 
   export function AddFrequency(
     frequency: number,
     callign: string,
     outputVolume?: number,
   ): Promise<boolean>;
+  export function AddFrequencyAsync(
+    frequency: number,
+    callign: string,
+    outputVolume?: number,
+  ): Promise<AsyncResult<boolean>>;
   export function RemoveFrequency(
     frequency: number,
     callsign?: string,
@@ -88,6 +208,9 @@ declare namespace TrackAudioAfv {
     outputGain?: number,
   ): Promise<boolean>;
 
+  export function AddFrequencies(records: FrequencyStateRecord[]): boolean[];
+  export function SetFrequencyStates(records: FrequencyStateRecord[]): boolean[];
+
   export function GetFrequencyState(frequency: number): Promise<{
     rx: boolean;
     tx: boolean;
@@ -98,6 +221,7 @@ declare namespace TrackAudioAfv {
   }>;
 
   export function SetCid(cid: string): void;
+  export function GetNetworkSession(): NetworkSession;
 
   export function SetMainRadioVolume(volume: number): void;
   export function SetMicrophoneVolume(volume: number): void;
@@ -110,7 +234,12 @@ declare namespace TrackAudioAfv {
 
   export function SetHardwareType(type: number): void;
 
+  export function StartAudio(): void;
+  export function StartAudioAsync(): Promise<AsyncResult<boolean>>;
+  export function StopAudio(): void;
+
   export function StartMicTest(): void;
+  export function ReadInputLevels(levels: Float32Array): boolean;
   export function StopMicTest(): void;
 
   export function PlayAdHocSound(wavFilePath: string, gain: number, target: number): void;
@@ -119,9 +248,11 @@ declare namespace TrackAudioAfv {
   export function SetLoopback(enabled: boolean, target: number, gain: number, hardware: number): void;
 
   export function RegisterCallback(
-    func: (arg: string, arg2: string, arg3: string, arg4: string) => void
+    func: (events: AfvEvent[]) => void
   ): void;
 
+  export function GetEventQueueStats(): EventQueueStats;
+
   export function SetupPttBegin(pttIndex: number, shouldListenForJoysticks?: boolean): void;
   export function SetupPttEnd(): void;
 
@@ -134,10 +265,33 @@ declare namespace TrackAudioAfv {
     version: string;
     checkSuccessful: boolean;
   };
+  export function GetVersionCheckResult(): Promise<AsyncResult<VersionCheckResult>>;
+  export function GetStartupReport(): {
+    latest: StartupReport;
+    history: StartupReport[];
+  };
+
+  export function GetPttLatencyReport(): PttLatencyReport;
+  export function ResetPttLatencyReport(): void;
 
   export function GetLoggerFilePath(): string;
 
   export function Exit(): boolean;
 
   export function SetSession(session: Session): void;
+  export function StartTraceRecording(tracePath?: string): string;
+  export function StopTraceRecording(): number;
+
+  export function SetRemoteEndpoints(endpoints: RemoteEndpoints): void;
+
+  // Only exported by builds with TRACKAUDIO_FAKE_AFV
+  export const RunAfvEventScript:
+    | ((scriptPath: string, speed?: number, repeat?: number) => void)
+    | undefined;
+  export const StopAfvEventScript: (() => void) | undefined;
+  export const ReplayTrace: ((tracePath: string, speed?: number) => void) | undefined;
+  export const StopTraceReplay: (() => void) | undefined;
+  export const StartSlurperStandIn: ((scriptPath: string) => string) | undefined;
+  export const StopSlurperStandIn: (() => void) | undefined;
+  export const GetSlurperStandInRequests: (() => SlurperStandInRequest[]) | undefined;
 }
@@ -12,7 +12,7 @@ import {
 import { electronApp, is, optimizer } from '@electron-toolkit/utils';
 import Store from 'electron-store';
 import { join } from 'path';
-import { AfvEventTypes, TrackAudioAfv } from 'trackaudio-afv';
+import { AfvEvent, AfvEventArg, AfvEventTypes, TrackAudioAfv } from 'trackaudio-afv';
 import icon from '../../resources/AppIcon/icon.png?asset';
 import updater from 'electron-updater';
 import log from 'electron-log/main';
@@ -20,6 +20,8 @@ import { ENV } from './env';
 import configManager from './config';
 import { AlwaysOnTopMode, RadioEffects } from '../shared/config.type';
 import { MainVolumeChange } from '../shared/MainVolumeChange';
+import { FrequencyStateRecord } from '../shared/FrequencyStateRecord';
+import { NetworkSession } from '../shared/NetworkSession';
 
 type WindowMode = 'mini' | 'maxi';
 
@@ -41,7 +43,7 @@ let autoOpenSettings = false;
 const store = new Store({ clearInvalidConfig: true });
 configManager.setStore(store);
 
-const eventQueue: [string, string, string, string][] = [];
+const eventQueue: AfvEvent[] = [];
 
 /**
  * Sets the always on top state for the main window, with different
@@ -81,8 +83,8 @@ const applyLoopbackSettings = () => {
   TrackAudioAfv.SetLoopback(loopbackEnabled, loopbackTarget, loopbackGain / 100, hardwareType);
 };
 
-const setAudioSettings = () => {
-  TrackAudioAfv.SetAudioSettings(
+const setAudioSettings = async () => {
+  await TrackAudioAfv.SetAudioSettingsAsync(
     configManager.config.audioApi,
     configManager.config.audioInputDeviceId,
     configManager.config.headsetOutputDeviceId,
@@ -370,6 +372,15 @@ app
       canRun: boolean;
     };
 
+    // Lets the session logic run against a local stand-in, e.g. one started with
+    // StartSlurperStandIn from a test harness
+    if (process.env.TRACKAUDIO_SLURPER_URL || process.env.TRACKAUDIO_VERSION_CHECK_URL) {
+      TrackAudioAfv.SetRemoteEndpoints({
+        slurperBaseUrl: process.env.TRACKAUDIO_SLURPER_URL,
+        versionCheckBaseUrl: process.env.TRACKAUDIO_VERSION_CHECK_URL
+      });
+    }
+
     const _v = (i: string) => Buffer.from(i, 'base64').toString('utf8');
 
     if (ENV[_v('VklURV9BRlZfVVJM')]) {
@@ -425,6 +436,18 @@ app
     TrackAudioAfv.SetPttReleaseSoundEnabled(configManager.config.pttReleaseSoundEnabled);
 
     createWindow();
+
+    // The mandatory version is fetched in the background, Connect is refused until it is known
+    void TrackAudioAfv.GetVersionCheckResult().then(({ data }) => {
+      if (data.needUpdate) {
+        dialog.showMessageBoxSync({
+          type: 'error',
+          message: 'A new mandatory version is available, please update in order to continue.',
+          buttons: ['OK']
+        });
+        app.quit();
+      }
+    });
   })
   .catch((e: unknown) => {
     const err = e as Error;
@@ -439,9 +462,8 @@ app.on('before-quit', () => {
     if (TrackAudioAfv.IsConnected()) {
       TrackAudioAfv.Disconnect();
     }
-    // Stop mic test after disconnect to ensure the VU meter thread is joined
-    // before Exit() destroys the client. StopMicTest calls StopAudio(),
-    // so it must run after Disconnect which needs audio still active.
+    // Stop mic test before Exit() destroys the client. StopMicTest calls
+    // StopAudio(), so it must run after Disconnect which needs audio still active.
     TrackAudioAfv.StopMicTest();
     TrackAudioAfv.Exit();
     isNativeExited = true;
@@ -541,15 +563,15 @@ ipcMain.handle('stop-ad-hoc-sounds', () => {
 });
 
 ipcMain.handle('audio-get-apis', () => {
-  return TrackAudioAfv.GetAudioApis();
+  return TrackAudioAfv.GetAudioApis().apis;
 });
 
-ipcMain.handle('audio-get-input-devices', (_, apiId: string) => {
-  return TrackAudioAfv.GetAudioInputDevices(apiId);
+ipcMain.handle('audio-get-input-devices', async (_, apiId: number) => {
+  return (await TrackAudioAfv.GetAudioInputDevicesAsync(apiId)).data.devices;
 });
 
-ipcMain.handle('audio-get-output-devices', (_, apiId: string) => {
-  return TrackAudioAfv.GetAudioOutputDevices(apiId);
+ipcMain.handle('audio-get-output-devices', async (_, apiId: number) => {
+  return (await TrackAudioAfv.GetAudioOutputDevicesAsync(apiId)).data.devices;
 });
 
 ipcMain.handle('get-configuration', () => {
@@ -597,6 +619,10 @@ ipcMain.handle('set-cid', (_, cid: string) => {
   TrackAudioAfv.SetCid(cid);
 });
 
+ipcMain.handle('get-network-session', () => {
+  return TrackAudioAfv.GetNetworkSession();
+});
+
 ipcMain.handle('set-password', (_, password: string) => {
   configManager.updateConfig({ password });
 });
@@ -605,12 +631,12 @@ ipcMain.handle('set-password', (_, password: string) => {
 // AFV actions
 //
 
-ipcMain.handle('connect', () => {
+ipcMain.handle('connect', async () => {
   if (!configManager.config.password || !configManager.config.cid) {
     return false;
   }
-  setAudioSettings();
-  return TrackAudioAfv.Connect(configManager.config.password);
+  await setAudioSettings();
+  return (await TrackAudioAfv.ConnectAsync(configManager.config.password)).data;
 });
 
 ipcMain.handle('disconnect', () => {
@@ -619,11 +645,11 @@ ipcMain.handle('disconnect', () => {
 
 ipcMain.handle(
   'audio-add-frequency',
-  (_, frequency: number, callsign: string, outputVolume?: number) => {
+  async (_, frequency: number, callsign: string, outputVolume?: number) => {
     if (outputVolume) {
-      return TrackAudioAfv.AddFrequency(frequency, callsign, outputVolume);
+      return (await TrackAudioAfv.AddFrequencyAsync(frequency, callsign, outputVolume)).data;
     }
-    return TrackAudioAfv.AddFrequency(frequency, callsign);
+    return (await TrackAudioAfv.AddFrequencyAsync(frequency, callsign)).data;
   }
 );
 
@@ -662,6 +688,10 @@ ipcMain.handle(
   }
 );
 
+ipcMain.handle('audio-add-frequencies', (_, records: FrequencyStateRecord[]) => {
+  return TrackAudioAfv.AddFrequencies(records);
+});
+
 ipcMain.handle('audio-get-frequency-state', (_, frequency: number) => {
   return TrackAudioAfv.GetFrequencyState(frequency);
 });
@@ -709,13 +739,21 @@ ipcMain.handle('set-hardware-type', (_, hardwareType: number) => {
   applyLoopbackSettings();
 });
 
-ipcMain.handle('start-mic-test', () => {
-  setAudioSettings();
+ipcMain.handle('start-mic-test', async () => {
+  await setAudioSettings();
   TrackAudioAfv.StartMicTest();
 });
 
+const inputLevels = new Float32Array(2);
+
+ipcMain.handle('read-input-levels', () => {
+  if (!TrackAudioAfv.ReadInputLevels(inputLevels)) {
+    return null;
+  }
+  return [inputLevels[0], inputLevels[1]];
+});
+
 ipcMain.handle('stop-mic-test', () => {
-  mainWindow?.webContents.send('MicTest', '0.0', '0.0');
   TrackAudioAfv.StopMicTest();
 });
 
@@ -863,7 +901,7 @@ ipcMain.on('log-error', (_, message: string) => {
 // Callbacks
 //
 
-const handleEvent = (arg: string, arg2: string, arg3: string, arg4: string) => {
+const handleEvent = (arg: string, arg2: AfvEventArg, arg3: AfvEventArg, arg4: AfvEventArg) => {
   if (!arg || isNativeExited) return;
 
   if (!isAppReady) {
@@ -871,10 +909,6 @@ const handleEvent = (arg: string, arg2: string, arg3: string, arg4: string) => {
     return;
   }
 
-  if (arg === AfvEventTypes.VuMeter) {
-    mainWindow?.webContents.send('VuMeter', arg2, arg3);
-  }
-
   if (arg === AfvEventTypes.FrequencyRxBegin) {
     mainWindow?.webContents.send('FrequencyRxBegin', arg2);
   }
@@ -899,8 +933,12 @@ const handleEvent = (arg: string, arg2: string, arg3: string, arg4: string) => {
     mainWindow?.webContents.send('station-state-update', arg2);
   }
 
+  if (arg == AfvEventTypes.StationStatesUpdate) {
+    mainWindow?.webContents.send('station-states-update', arg2);
+  }
+
   if (arg == AfvEventTypes.MainVolumeChange) {
-    const update = JSON.parse(arg2) as MainVolumeChange;
+    const update = arg2 as MainVolumeChange;
     configManager.updateConfig({ mainRadioVolume: update.value.volume });
     mainWindow?.webContents.send('main-volume-change', arg2);
   }
@@ -909,6 +947,10 @@ const handleEvent = (arg: string, arg2: string, arg3: string, arg4: string) => {
     mainWindow?.webContents.send('station-data-received', arg2, arg3);
   }
 
+  if (arg == AfvEventTypes.StationsDataReceived) {
+    mainWindow?.webContents.send('stations-data-received', arg2);
+  }
+
   if (arg == AfvEventTypes.PttState) {
     mainWindow?.webContents.send('PttState', arg2);
   }
@@ -932,8 +974,14 @@ const handleEvent = (arg: string, arg2: string, arg3: string, arg4: string) => {
   }
 
   if (arg == AfvEventTypes.NetworkConnected) {
-    mainWindow?.setTitle(`${arg2} - TrackAudio - Audio for VATSIM Client`);
-    mainWindow?.webContents.send('network-connected', arg2, arg3);
+    mainWindow?.setTitle(`${arg2 as string} - TrackAudio - Audio for VATSIM Client`);
+    mainWindow?.webContents.send('network-connected', arg2, arg3, arg4);
+  }
+
+  if (arg == AfvEventTypes.NetworkSessionChanged) {
+    const session = arg2 as NetworkSession;
+    mainWindow?.setTitle(`${session.callsign} - TrackAudio - Audio for VATSIM Client`);
+    mainWindow?.webContents.send('network-session-changed', session);
   }
 
   if (arg == AfvEventTypes.NetworkDisconnected) {
@@ -950,7 +998,11 @@ const handleEvent = (arg: string, arg2: string, arg3: string, arg4: string) => {
   }
 
   if (arg == AfvEventTypes.AudioDeviceStopped) {
-    mainWindow?.webContents.send('error', `Audio device disconnected: ${arg2}`);
+    mainWindow?.webContents.send('error', `Audio device disconnected: ${arg2 as string}`);
+  }
+
+  if (arg == AfvEventTypes.AudioDevicesChanged) {
+    mainWindow?.webContents.send('audio-devices-changed');
   }
 
   if (arg == AfvEventTypes.VoiceConnectionDegraded) {
@@ -962,4 +1014,10 @@ const handleEvent = (arg: string, arg2: string, arg3: string, arg4: string) => {
   }
 };
 
-TrackAudioAfv.RegisterCallback(handleEvent);
+const handleEventBatch = (events: AfvEvent[]) => {
+  for (const [arg, arg2, arg3, arg4] of events) {
+    handleEvent(arg, arg2, arg3, arg4);
+  }
+};
+
+TrackAudioAfv.RegisterCallback(handleEventBatch);
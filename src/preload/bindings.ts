@@ -2,6 +2,8 @@ import { ipcRenderer, IpcRendererEvent } from 'electron';
 
 import { AlwaysOnTopMode, RadioEffects } from '../shared/config.type';
 import { ProgressInfo, UpdateDownloadedEvent, UpdateInfo } from 'electron-updater';
+import { FrequencyStateRecord } from '../shared/FrequencyStateRecord';
+import { NetworkSession } from '../shared/NetworkSession';
 
 export const api = {
   /* eslint-disable  @typescript-eslint/no-explicit-any */
@@ -72,6 +74,8 @@ export const api = {
   connect: () => ipcRenderer.invoke('connect'),
   disconnect: () => ipcRenderer.invoke('disconnect'),
   setCid: (cid: string) => ipcRenderer.invoke('set-cid', cid),
+  GetNetworkSession: (): Promise<NetworkSession & { isConnected: boolean }> =>
+    ipcRenderer.invoke('get-network-session'),
   setPassword: (password: string) => ipcRenderer.invoke('set-password', password),
 
   GetStation: (callsign: string) => ipcRenderer.invoke('get-station', callsign),
@@ -79,6 +83,8 @@ export const api = {
 
   addFrequency: (frequency: number, callsign: string, outputVolume?: number) =>
     ipcRenderer.invoke('audio-add-frequency', frequency, callsign, outputVolume),
+  addFrequencies: (records: FrequencyStateRecord[]): Promise<boolean[]> =>
+    ipcRenderer.invoke('audio-add-frequencies', records),
   removeFrequency: (frequency: number, callsign?: string) =>
     ipcRenderer.invoke('audio-remove-frequency', frequency, callsign),
   IsFrequencyActive: (frequency: number) =>
@@ -128,6 +134,8 @@ export const api = {
   getVersion: () => ipcRenderer.invoke('get-version'),
 
   StartMicTest: () => ipcRenderer.invoke('start-mic-test'),
+  ReadInputLevels: (): Promise<[number, number] | null> =>
+    ipcRenderer.invoke('read-input-levels'),
   StopMicTest: () => ipcRenderer.invoke('stop-mic-test'),
 
   PlayAdHocSound: (wavFileName: string, gain: number, target: number) =>
@@ -84,6 +84,47 @@ const SettingsModal: React.FC<SettingsModalProps> = ({ closeModal }) => {
   ]);
   const [isMicTesting, setIsMicTesting] = useState(false);
 
+  // Sample the input levels at about 30 Hz while the mic test runs, on animation frames so the
+  // meter repaints with the read, skipping frames while a read is still in flight
+  useEffect(() => {
+    if (!isMicTesting) {
+      updateVu(0, 0);
+      return;
+    }
+
+    // Slightly under 1000 / 30 so frame timestamp jitter does not skip a second frame at 60 Hz
+    const readIntervalMs = 30;
+    let frame = 0;
+    let isReading = false;
+    let lastReadTime = -Infinity;
+    const readLevels = (time: DOMHighResTimeStamp) => {
+      if (!isReading && time - lastReadTime >= readIntervalMs) {
+        isReading = true;
+        lastReadTime = time;
+        window.api
+          .ReadInputLevels()
+          .then((levels) => {
+            if (levels) {
+              // Convert to a scale of 0 - 100
+              updateVu(Math.abs(levels[0]) * 100, Math.abs(levels[1]) * 100);
+            }
+          })
+          .catch((err: unknown) => {
+            console.error(err);
+          })
+          .finally(() => {
+            isReading = false;
+          });
+      }
+      frame = requestAnimationFrame(readLevels);
+    };
+    frame = requestAnimationFrame(readLevels);
+
+    return () => {
+      cancelAnimationFrame(frame);
+    };
+  }, [isMicTesting, updateVu]);
+
   useEffect(() => {
     window.api
       .getConfig()
@@ -114,32 +155,38 @@ const SettingsModal: React.FC<SettingsModalProps> = ({ closeModal }) => {
     if (!config.audioApi && config.audioApi !== 0) {
       return;
     }
-    window.api
-      .getAudioApis()
-      .then((apis: AudioApi[]) => {
-        setAudioApis(apis);
-      })
-      .catch((err: unknown) => {
-        console.error(err);
-      });
-
-    window.api
-      .getAudioOutputDevices(config.audioApi)
-      .then((devices: AudioDevice[]) => {
-        setAudioOutputDevices(devices);
-      })
-      .catch((err: unknown) => {
-        console.error(err);
-      });
-
-    window.api
-      .getAudioInputDevices(config.audioApi)
-      .then((devices: AudioDevice[]) => {
-        setAudioInputDevices(devices);
-      })
-      .catch((err: unknown) => {
-        console.error(err);
-      });
+    const loadAudioDevices = () => {
+      window.api
+        .getAudioApis()
+        .then((apis: AudioApi[]) => {
+          setAudioApis(apis);
+        })
+        .catch((err: unknown) => {
+          console.error(err);
+        });
+
+      window.api
+        .getAudioOutputDevices(config.audioApi)
+        .then((devices: AudioDevice[]) => {
+          setAudioOutputDevices(devices);
+        })
+        .catch((err: unknown) => {
+          console.error(err);
+        });
+
+      window.api
+        .getAudioInputDevices(config.audioApi)
+        .then((devices: AudioDevice[]) => {
+          setAudioInputDevices(devices);
+        })
+        .catch((err: unknown) => {
+          console.error(err);
+        });
+    };
+    loadAudioDevices();
+
+    // The backend caches the device lists and tells us when a refresh changed them
+    return window.api.onIpc('audio-devices-changed', loadAudioDevices);
   }, [config.audioApi]);
 
   const debouncedCid = useDebouncedCallback((cid: string) => {
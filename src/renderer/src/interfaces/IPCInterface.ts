@@ -5,7 +5,9 @@ import { Configuration } from 'src/shared/config.type';
 import { StationStateUpdate } from './StationStateUpdate';
 import useErrorStore from '@renderer/store/errorStore';
 import { MainVolumeChange } from 'src/shared/MainVolumeChange';
+import { NetworkSession } from 'src/shared/NetworkSession';
 import { Station } from './Station';
+import { FrequencyStateRecord } from 'src/shared/FrequencyStateRecord';
 
 class IPCInterface {
   public init() {
@@ -30,20 +32,11 @@ class IPCInterface {
         window.api.log.error(err as string);
       });
 
-    window.api.on('VuMeter', (vu: string, peakVu: string) => {
-      const vuFloat = Math.abs(parseFloat(vu));
-      const peakVuFloat = Math.abs(parseFloat(peakVu));
-
-      // Convert to a scale of 0 - 100
-      utilStoreState.updateVu(vuFloat * 100, peakVuFloat * 100);
-    });
-
-    window.api.on('station-transceivers-updated', (station: string, count: string) => {
-      radioStoreState.setTransceiverCountForStationCallsign(station, parseInt(count));
+    window.api.on('station-transceivers-updated', (station: string, count: number) => {
+      radioStoreState.setTransceiverCountForStationCallsign(station, count);
     });
 
-    window.api.on('station-data-received', (station: string, data: string) => {
-      const radio = JSON.parse(data) as Station;
+    window.api.on('station-data-received', (station: string, radio: Station) => {
       const storedStationVolume = window.localStorage.getItem(station + 'StationVolume');
       const storedStationVolumeInt = storedStationVolume
         ? parseInt(storedStationVolume)
@@ -65,12 +58,40 @@ class IPCInterface {
         });
     });
 
+    // Received with the stations of a VCCS lookup, added in one call so the backend applies them
+    // in one transaction with a single transceiver fetch per station
+    window.api.on('stations-data-received', (stations: (Station & { callsign: string })[]) => {
+      const records: FrequencyStateRecord[] = stations.map((station) => {
+        const storedStationVolume = window.localStorage.getItem(station.callsign + 'StationVolume');
+        return {
+          frequency: station.frequency,
+          callsign: station.callsign,
+          outputVolume: storedStationVolume ? parseInt(storedStationVolume) : undefined
+        };
+      });
+
+      window.api
+        .addFrequencies(records)
+        .then((results) => {
+          const stationCallsign = useSessionStore.getState().getStationCallsign();
+          stations.forEach((station, i) => {
+            if (!results[i]) {
+              console.error('Failed to add frequency', station.frequency, station.callsign);
+              return;
+            }
+            useRadioState.getState().addRadioByStation(station, stationCallsign);
+          });
+        })
+        .catch((err: unknown) => {
+          console.error(err);
+        });
+    });
+
     // Received when a station's state is updated externally, typically
     // by another client via a websocket message. When received go through
     // and ensure the state of the button in TrackAudio matches the new
     // state in AFV.
-    window.api.on('station-state-update', (data: string) => {
-      const update = JSON.parse(data) as StationStateUpdate;
+    const applyStationStateUpdate = (update: StationStateUpdate) => {
       const radio = radioStoreState.getRadioByFrequency(update.value.frequency);
 
       if (!radio) {
@@ -93,59 +114,63 @@ class IPCInterface {
         outputVolume: update.value.outputVolume,
         isOutputMuted: update.value.isOutputMuted
       });
+    };
+    window.api.on('station-state-update', applyStationStateUpdate);
+
+    // Bulk frequency changes are notified once with every updated station
+    window.api.on('station-states-update', (updates: StationStateUpdate[]) => {
+      updates.forEach(applyStationStateUpdate);
     });
 
-    window.api.on('main-volume-change', (data: string) => {
-      const change = JSON.parse(data) as MainVolumeChange;
+    window.api.on('main-volume-change', (change: MainVolumeChange) => {
       sessionStoreState.setMainRadioVolume(change.value.volume);
     });
 
-    window.api.on('FrequencyRxBegin', (frequency: string) => {
-      if (radioStoreState.isInactive(parseInt(frequency))) {
+    window.api.on('FrequencyRxBegin', (frequency: number) => {
+      if (radioStoreState.isInactive(frequency)) {
         return;
       }
-      radioStoreState.setCurrentlyRx(parseInt(frequency), true);
+      radioStoreState.setCurrentlyRx(frequency, true);
     });
 
     window.api.on(
       'StationRxBegin',
-      (frequency: string, _callsign: string, activeTransmitters: string[]) => {
-        if (radioStoreState.isInactive(parseInt(frequency))) {
+      (frequency: number, _callsign: string, activeTransmitters: string[]) => {
+        if (radioStoreState.isInactive(frequency)) {
           return;
         }
 
         // On begin, use the complete list of transmitters
-        radioStoreState.setLastReceivedCallsigns(parseInt(frequency), activeTransmitters);
+        radioStoreState.setLastReceivedCallsigns(frequency, activeTransmitters);
       }
     );
 
     window.api.on(
       'StationRxEnd',
-      (frequency: string, callsign: string, activeTransmitters: string[]) => {
-        if (radioStoreState.isInactive(parseInt(frequency))) {
+      (frequency: number, callsign: string, activeTransmitters: string[]) => {
+        if (radioStoreState.isInactive(frequency)) {
           return;
         }
 
         if (activeTransmitters.length > 0) {
           // If others are still transmitting, show them
-          radioStoreState.setLastReceivedCallsigns(parseInt(frequency), activeTransmitters);
+          radioStoreState.setLastReceivedCallsigns(frequency, activeTransmitters);
         } else {
           // If no one is transmitting, keep who just stopped as the last received
-          radioStoreState.setLastReceivedCallsigns(parseInt(frequency), [callsign]);
+          radioStoreState.setLastReceivedCallsigns(frequency, [callsign]);
         }
       }
     );
 
-    window.api.on('FrequencyRxEnd', (frequency: string) => {
-      if (radioStoreState.isInactive(parseInt(frequency))) {
+    window.api.on('FrequencyRxEnd', (frequency: number) => {
+      if (radioStoreState.isInactive(frequency)) {
         return;
       }
 
-      radioStoreState.setCurrentlyRx(parseInt(frequency), false);
+      radioStoreState.setCurrentlyRx(frequency, false);
     });
 
-    window.api.on('PttState', (state) => {
-      const pttState = state === '1' ? true : false;
+    window.api.on('PttState', (pttState: boolean) => {
       radioStoreState.setCurrentlyTx(pttState);
     });
 
@@ -177,16 +202,19 @@ class IPCInterface {
       sessionStoreState.setIsConnectionDegraded(false);
     });
 
-    window.api.on('network-connected', (callsign: string, dataString: string) => {
+    window.api.on('network-connected', (callsign: string, isAtc: boolean, frequency: number) => {
       sessionStoreState.setNetworkConnected(true);
       sessionStoreState.setCallsign(callsign);
-      const dataArr = dataString.split(',');
-      const isAtc = dataArr[0] === '1';
-      const frequency = parseInt(dataArr[1]);
       sessionStoreState.setIsAtc(isAtc);
       sessionStoreState.setFrequency(frequency);
     });
 
+    window.api.on('network-session-changed', (session: NetworkSession) => {
+      sessionStoreState.setCallsign(session.callsign);
+      sessionStoreState.setIsAtc(session.isAtc);
+      sessionStoreState.setFrequency(session.frequency);
+    });
+
     window.api.on('network-disconnected', () => {
       sessionStoreState.setNetworkConnected(false);
       sessionStoreState.setCallsign('');
@@ -194,9 +222,24 @@ class IPCInterface {
       sessionStoreState.setFrequency(199998000);
     });
 
-    window.api.on('ptt-key-set', (pttIndex: string, key: string) => {
-      const index = parseInt(pttIndex);
+    // The session events are only sent when it changes, a window loaded after the slurper was
+    // first polled pulls the current one
+    window.api
+      .GetNetworkSession()
+      .then((session) => {
+        if (!session.isConnected) {
+          return;
+        }
+        sessionStoreState.setNetworkConnected(true);
+        sessionStoreState.setCallsign(session.callsign);
+        sessionStoreState.setIsAtc(session.isAtc);
+        sessionStoreState.setFrequency(session.frequency);
+      })
+      .catch((err: unknown) => {
+        window.api.log.error(err as string);
+      });
 
+    window.api.on('ptt-key-set', (index: number, key: string) => {
       if (index == 1) {
         utilStoreState.updatePtt1KeySet(true);
         utilStoreState.setPtt1KeyName(key);
@@ -226,9 +269,9 @@ class IPCInterface {
   }
 
   public destroy() {
-    window.api.removeAllListeners('VuMeter');
     window.api.removeAllListeners('station-transceivers-updated');
     window.api.removeAllListeners('station-data-received');
+    window.api.removeAllListeners('stations-data-received');
     window.api.removeAllListeners('FrequencyRxBegin');
     window.api.removeAllListeners('StationRxBegin');
     window.api.removeAllListeners('FrequencyRxEnd');
@@ -237,9 +280,11 @@ class IPCInterface {
     window.api.removeAllListeners('VoiceConnected');
     window.api.removeAllListeners('VoiceDisconnected');
     window.api.removeAllListeners('network-connected');
+    window.api.removeAllListeners('network-session-changed');
     window.api.removeAllListeners('network-disconnected');
     window.api.removeAllListeners('ptt-key-set');
     window.api.removeAllListeners('station-state-update');
+    window.api.removeAllListeners('station-states-update');
     window.api.removeAllListeners('main-volume-change');
     window.api.removeAllListeners('VoiceConnectionDegraded');
     window.api.removeAllListeners('VoiceConnectionResumed');
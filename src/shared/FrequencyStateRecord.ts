@@ -0,0 +1,11 @@
+export interface FrequencyStateRecord {
+  frequency: number;
+  callsign?: string;
+  rx?: boolean;
+  tx?: boolean;
+  xc?: boolean;
+  onSpeaker?: boolean;
+  crossCoupleAcross?: boolean;
+  isOutputMuted?: boolean;
+  outputVolume?: number;
+}
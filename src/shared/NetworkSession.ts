@@ -0,0 +1,7 @@
+export interface NetworkSession {
+  callsign: string;
+  isAtc: boolean;
+  frequency: number;
+  lat: number;
+  lon: number;
+}